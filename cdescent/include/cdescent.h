@@ -15,6 +15,8 @@ extern "C" {
 #include <stdbool.h>
 #include <mmreal.h>
 #include <objects.h>
+#include <penalty.h>
+#include <provider.h>
 #include <linregmodel.h>
 #include <regression.h>
 
@@ -24,11 +26,20 @@ void		cdescent_free (cdescent *cd);
 
 void		cdescent_set_cyclic (cdescent *cd);
 void		cdescent_set_stochastic (cdescent *cd, const unsigned int *seed);
+void		cdescent_set_importance_sampling (cdescent *cd);
+void		cdescent_set_accelerated (cdescent *cd, const unsigned int *seed);
+void		cdescent_set_greedy (cdescent *cd, const int ncache);
+void		cdescent_set_block (cdescent *cd, const int size);
+void		cdescent_set_svrg (cdescent *cd, const int batch, const unsigned int *seed);
+void		cdescent_set_anderson (cdescent *cd, const int k);
+void		cdescent_set_row_parallel (cdescent *cd);
+void		cdescent_use_first_touch (cdescent *cd);
 
 bool		cdescent_set_penalty_factor (cdescent *cd, const mm_dense *w, const double tau);
 
 void		cdescent_not_use_intercept (cdescent *cd);
 void		cdescent_set_constraint (cdescent *cd, constraint_func func);
+void		cdescent_set_box_constraint (cdescent *cd, const double lower, const double upper);
 void		cdescent_use_fixed_lambda (cdescent *cd, const double lambda);
 
 void		cdescent_set_lambda (cdescent *cd, const double lambda);
@@ -43,6 +54,7 @@ void		cdescent_set_outputs_info (cdescent *cd, const char *fn);
 double		cdescent_get_intercept_in_original_scale (const cdescent *cd);
 mm_dense	*cdescent_get_beta_in_original_scale (const cdescent *cd);
 void		cdescent_init_beta (cdescent *cd, const mm_dense *beta);
+long		cdescent_num_allocated (void);
 
 #ifdef __cplusplus
 }
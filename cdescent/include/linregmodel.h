@@ -18,6 +18,8 @@ extern "C" {
 
 /* linregmodel.c */
 linregmodel	*linregmodel_new (mm_dense *y, mm_real *x, mm_real *d, PreProc proc);
+linregmodel	*linregmodel_new_with_penalty (mm_dense *y, mm_real *x, const penalty *pen, PreProc proc);
+linregmodel	*linregmodel_new_with_provider (mm_dense *y, provider *prov, const penalty *pen, PreProc proc);
 void		linregmodel_free (linregmodel *l);
 
 #ifdef __cplusplus
@@ -12,6 +12,8 @@
 extern "C" {
 #endif
 
+#include <stdio.h>
+#include <stdint.h>
 #include <stdbool.h>
 #include <mmio.h>
 
@@ -38,6 +40,47 @@ typedef enum {
 	MM_REAL_SYMMETRIC_LOWER = MM_SYMMETRIC | MM_LOWER	// symmetric lower triangular
 } MMRealSymm;
 
+/* format of columns of X stored in the kernel matrix container (see provider.h) */
+typedef enum {
+	MM_REAL_XMAT_FLOAT64 = 0,	// double
+	MM_REAL_XMAT_FLOAT32 = 1,	// float
+	MM_REAL_XMAT_INT16   = 2	// int16 quantized with scale of each column (float)
+} MMRealXmatFormat;
+
+/* version of the kernel matrix container written by mm_real_xmatfile_header_write */
+#define MM_REAL_XMATFILE_VERSION	2
+/* alignment of the columns in the container in bytes, which is a multiple of the page size */
+#define MM_REAL_XMATFILE_ALIGN		4096
+/* initial value of mm_real_xmatfile_hash */
+#define MM_REAL_XMATFILE_HASH_INIT	0xcbf29ce484222325ULL
+
+/* header of the kernel matrix container.
+ * The container holds the normalized columns of X of size m x n, which are grouped into
+ * ntiles tiles of tile consecutive columns (the last one may be shorter).
+ * The rows of X are divided into nrowblocks row blocks of rowblock consecutive rows
+ * (the last one may be shorter), and each tile is stored as its row blocks in order,
+ * each of which holds the records of its rows of the columns of the tile.
+ * So t-th tile is placed at offset + t * tile * reclen, and a row block of a tile is
+ * read at once. If rowblock = m, j-th column is placed at offset + j * reclen */
+typedef struct s_mm_real_xmatfile_header	mm_real_xmatfile_header;
+
+struct s_mm_real_xmatfile_header {
+	int					version;
+	MMRealXmatFormat	format;		// format of the columns
+	int					m;
+	int					n;
+	int					tile;		// num of columns of a tile
+	int					ntiles;		// num of tiles
+	int					rowblock;	// num of rows of a row block
+	int					nrowblocks;	// num of row blocks
+	uint64_t			fingerprint;// hash of the settings which X is calculated from, given by the user
+	size_t				reclen;		// size of a column in bytes, which is the sum of the records of all row blocks
+	size_t				offset;		// offset of the first tile, aligned to MM_REAL_XMATFILE_ALIGN
+	uint64_t			*checksum;	// hash of each tile continued over its row blocks: size ntiles
+	double				*sx;		// sum of each column of X before normalized: size n
+	double				*xtx;		// squared norm of each column of X before normalized: size n
+};
+
 #define mm_real_is_sparse(a)		mm_is_sparse((a)->typecode)
 #define mm_real_is_dense(a)			mm_is_dense((a)->typecode)
 #define mm_real_is_symmetric(a)		(mm_is_symmetric((a)->typecode) && ((a)->symm & MM_SYMMETRIC))
@@ -64,19 +107,29 @@ struct s_mm_real {
 	int			*i;			// row index of each nonzero elements: size = nnz
 	int			*p;			// p[0] = 0, p[j+1] = num of nonzeros in X(:,1:j): size = n + 1
 	double		*data;		// nonzero matrix elements: size = nnz
+
+	/* sparse: transposed (row) index of the elements of each row (CSR mirror),
+	 * built by mm_real_build_transposed_index. If symmetric, off-diagonal elements only,
+	 * which is built on first use of a column. NULL if not built */
+	int			*tp;		// tp[i] ... tp[i+1]-1: elements of i-th row: size = m + 1
+	int			*tj;		// column index of each element
+	int			*tl;		// index of each element in i and data
 };
 
 mm_real		*mm_real_new (MMRealFormat format, MMRealSymm symm, const int m, const int n, const int nnz);
 void		mm_real_free (mm_real *mm);
 bool		mm_real_realloc (mm_real *mm, const int nnz);
+long		mm_real_num_allocated (void);
 
 void		mm_real_sort (mm_real *x);
+void		mm_real_build_transposed_index (mm_sparse *s);
 
 void		mm_real_memcpy (mm_real *dest, const mm_real *src);
 mm_real		*mm_real_copy (const mm_real *mm);
 mm_dense	*mm_real_copy_sparse_to_dense (const mm_sparse *s);
 mm_sparse	*mm_real_copy_dense_to_sparse (const mm_dense *x, const double threshold);
 void		mm_real_set_all (mm_real *mm, const double val);
+void		mm_real_first_touch (mm_real *x, const bool rowwise, const double val);
 
 bool		mm_real_sparse_to_dense (mm_sparse *s);
 bool		mm_real_dense_to_sparse (mm_dense *d, const double threshold);
@@ -105,10 +158,29 @@ mm_dense	*mm_real_xj_trans_dot_y (const mm_real *x, const int j, const mm_dense
 
 void		mm_real_axjpy (const double alpha, const mm_real *x, const int j, mm_dense *y);
 void		mm_real_axjpy_atomic (const double alpha, const mm_real *x, const int j, mm_dense *y);
+double		mm_real_axjpy_xk_trans_dot_y (const double alpha, const mm_real *x, const int j, const int k, mm_dense *y);
 
 mm_real		*mm_real_fread (FILE *fp);
 void		mm_real_fwrite (FILE *stream, const mm_real *x, const char *format);
 
+size_t		mm_real_xmatfile_record_size (const MMRealXmatFormat format, const int m);
+void		mm_real_xmatfile_encode (const MMRealXmatFormat format, const int m, const double *xj, void *rec);
+void		mm_real_xmatfile_decode (const MMRealXmatFormat format, const int m, const void *rec, double *xj);
+uint64_t	mm_real_xmatfile_hash (const void *buf, const size_t len, uint64_t hash);
+
+mm_real_xmatfile_header	*mm_real_xmatfile_header_new (const MMRealXmatFormat format, const int m, const int n,
+							const int tile, const int rowblock, const uint64_t fingerprint);
+void		mm_real_xmatfile_header_free (mm_real_xmatfile_header *h);
+void		mm_real_xmatfile_header_write (FILE *fp, const mm_real_xmatfile_header *h);
+mm_real_xmatfile_header	*mm_real_xmatfile_header_read (FILE *fp);
+size_t		mm_real_xmatfile_tile_offset (const mm_real_xmatfile_header *h, const int t);
+int			mm_real_xmatfile_tile_ncols (const mm_real_xmatfile_header *h, const int t);
+int			mm_real_xmatfile_block_nrows (const mm_real_xmatfile_header *h, const int b);
+size_t		mm_real_xmatfile_record_offset (const mm_real_xmatfile_header *h, const int j, const int b);
+int			mm_real_xmatfile_tile_width (const MMRealXmatFormat format, const int m, const int rowblock, const size_t size);
+size_t		mm_real_xmatfile_block_size (const mm_real_xmatfile_header *h, const int t, const int b);
+bool		mm_real_xmatfile_verify (FILE *fp, const mm_real_xmatfile_header *h);
+
 #ifdef __cplusplus
 }
 #endif
@@ -12,12 +12,21 @@
 extern "C" {
 #endif
 
+#include <stdio.h>
+#include <pthread.h>
+
 typedef struct s_cdescent		cdescent;
 typedef struct s_linregmodel	linregmodel;
+typedef struct s_penalty		penalty;
+typedef struct s_provider		provider;
 
 typedef enum {
 	CDESCENT_SELECTION_RULE_CYCLIC,		// use cyclic coordinate descent update
-	CDESCENT_SELECTION_RULE_STOCHASTIC	// use stochastic coordinate descent update
+	CDESCENT_SELECTION_RULE_STOCHASTIC,	// use stochastic coordinate descent update
+	CDESCENT_SELECTION_RULE_ACCELERATED,	// use accelerated randomized coordinate descent update
+	CDESCENT_SELECTION_RULE_GREEDY,		// use greedy (Gauss-Southwell-Lipschitz) coordinate descent update
+	CDESCENT_SELECTION_RULE_BLOCK,		// use block coordinate descent update over consecutive columns
+	CDESCENT_SELECTION_RULE_SVRG		// use proximal stochastic variance reduced gradient over mini-batches of rows
 } CoordinateSelectionRule;
 
 /*** constraint_fun
@@ -53,25 +62,171 @@ typedef bool (*constraint_func) (cdescent *cd, const int j, const double etaj, d
  *     cd->beta[j] -> *forced
  */
 
+/*** sweep_func
+ * pointer of the function which progresses one sweep of serial cyclic coordinate descent,
+ * specialized for the settings of cdescent (see sweep.c) ***/
+typedef void (*sweep_func) (cdescent *cd);
+
+/*** random selection of coordinates for the stochastic and accelerated rules.
+ * Each thread has its own generator (xoshiro256**, see private/random.h),
+ * and the buffer of the selected coordinates is reused for every sweep ***/
+typedef struct s_sampler	sampler;
+
+struct s_sampler {
+	unsigned int			seed;					// seed of the generators
+	int						nrng;					// number of generators
+	struct s_xoshiro256		*rng;					// generator of each thread
+
+	int						n;						// number of coordinates
+	int						*index;					// selected coordinates of a sweep: size n
+	int						nsel;					// num of coordinates selected in current sweep
+
+	bool					importance;				// select coordinates in proportion to their curvature
+	double					lambda2;				// lambda2 for which the alias table was built
+	double					*prob;					// alias table (Walker, 1977): probabilities
+	int						*alias;					// alias table: aliases
+	int						*stack;					// work space to build the alias table: size 2n
+	bool					*drawn;					// work space to remove the repeated draws: size n
+};
+
+/*** state of greedy coordinate descent (Gauss-Southwell-Lipschitz rule, Nutini et al., 2015).
+ * X' * mu and D' * nu are kept up to date by the columns of the Gram matrices
+ * X' * X and D' * D, which are computed on demand and cached ***/
+typedef struct s_greedy	greedy;
+
+struct s_greedy {
+	mm_dense				*xmu;					// X' * mu: size n
+	mm_dense				*dnu;					// D' * nu: size n
+
+	int						ncache;					// number of cached columns of the Gram matrices
+	int						*slot;					// slot[j]: cache slot of j-th column, or -1 if not cached: size n
+	int						*owner;					// owner[k]: column cached in k-th slot, or -1: size ncache
+	bool					*referred;				// reference bits for clock replacement: size ncache
+	int						hand;					// clock hand
+	mm_dense				**xtx;					// cached columns of X' * X
+	mm_dense				**dtd;					// cached columns of D' * D
+
+	mm_dense				*xj;					// work: X(:,j)
+	mm_dense				*dj;					// work: D(:,j)
+};
+
+/*** state of block coordinate descent.
+ * The coordinates are divided into blocks of consecutive columns of X,
+ * e.g. the cells of a depth layer, and each block is updated by a proximal gradient step.
+ * Only the Lipschitz constants of the blocks are kept, not their Gram matrices ***/
+typedef struct s_block	block;
+
+struct s_block {
+	int						size;					// number of coordinates of a block (the last one may be smaller)
+	int						nblocks;				// number of blocks
+
+	double					*lx;					// Lipschitz constants of X_B' * X_B of the blocks: nblocks
+	double					*ld;					// Lipschitz constants of D_B' * D_B of the blocks: nblocks
+
+	double					*xmu;					// X_B' * mu of current block: size
+	double					*dnu;					// D_B' * nu of current block: size
+	double					*eta;					// changes of beta_B of current block: size
+
+	mm_dense				*xeta;					// work: X_B * eta_B
+	mm_dense				*deta;					// work: D_B * eta_B
+};
+
+/*** state of proximal stochastic variance reduced gradient method (Prox-SVRG).
+ * The rows of X are divided into mini-batches of consecutive rows,
+ * which are submatrices of X with leading dimension m ***/
+typedef struct s_svrg	svrg;
+
+struct s_svrg {
+	int						batch;					// number of rows of a mini-batch (the last one may be smaller)
+	int						nbatches;				// number of mini-batches
+	int						nsteps;					// number of steps of current epoch
+
+	double					lambda;					// lambda at which the epochs were started
+	double					obj;					// value of objective function at the snapshot
+
+	double					lx;						// nbatches * max_B ||X_B||^2
+	double					ld;						// ||D||^2, step-size is 1 / (lx + lambda2 * ld)
+
+	mm_dense				*z0;					// negative gradient of smooth part at snapshot: size n
+	mm_dense				*beta0;					// snapshot of beta: size n
+	mm_dense				*delta;					// beta - beta0: size n
+	mm_dense				*v;						// estimate of negative gradient: size n
+	mm_dense				*t;						// X_B * delta: size batch
+	mm_dense				*ddelta;				// D * delta: size(D, 1)
+	mm_dense				*dtd;					// work: size n
+};
+
+/*** state of accelerated randomized coordinate descent (APPROX, Fercoq and Richtarik, 2015).
+ * The two sequences are kept implicitly as y = theta^2 * u + z, so that
+ * each coordinate update touches only z(j), u(j) and the columns X(:,j) and D(:,j) ***/
+typedef struct s_acceleration	acceleration;
+
+struct s_acceleration {
+	bool					restart;				// restart the sequences from beta at next cycle
+	int						ncycles;				// number of cycles since the (re)start
+	int						period;					// number of cycles between the fixed restarts
+	double					theta;					// current theta, theta = 1 / n at (re)start
+	double					lambda;					// lambda at which the sequences were started
+	double					obj;					// value of objective function at the end of previous cycle
+
+	mm_dense				*z;						// sequence z
+	mm_dense				*xz;					// X * z
+	mm_dense				*dz;					// D * z
+	mm_dense				*u;						// sequence u
+	mm_dense				*xu;					// X * u
+	mm_dense				*du;					// D * u
+};
+
+/*** state of Anderson extrapolation of coordinate descent sweeps (Bertrand and Massias, 2021).
+ * The last k + 1 iterates of beta and corresponding mu and nu are stored,
+ * and every k sweeps, they are extrapolated ***/
+typedef struct s_anderson	anderson;
+
+struct s_anderson {
+	int						k;						// number of sweeps between extrapolations
+	int						count;					// number of iterates stored in the buffer
+
+	mm_dense				*beta;					// last k + 1 iterates of beta: n x (k + 1)
+	mm_dense				*mu;					// corresponding mu: m x (k + 1)
+	mm_dense				*nu;					// corresponding nu: size(D, 1) x (k + 1)
+
+	mm_dense				*u;						// differences of iterates U = [beta_1 - beta_0, ...]: n x k
+	double					*utu;					// U' * U: k x k
+	double					*c;						// coefficients of extrapolation: size k
+
+	mm_dense				*ebeta;					// extrapolated beta
+	mm_dense				*emu;					// extrapolated mu
+	mm_dense				*enu;					// extrapolated nu
+};
+
+/*** work spaces of cdescent object, which are allocated once in cdescent_new
+ * and reused in every cycle, so that no memory is allocated during the regression ***/
+typedef struct s_workspace	workspace;
+
+struct s_workspace {
+	mm_dense	*beta;	// beta in original scale: size n
+	mm_dense	*r;		// residual y - mu - b0: size m
+};
+
 /*** object of coordinate descent regression for L1 regularized linear problem
  *       argmin_beta || y - x * beta ||^2 + lambda2 * || d * beta ||^2 + sum_j lambda1 * | beta_j |
  *   or
  *       argmin_beta || y - x * beta ||^2 + lambda2 * || d * beta ||^2  + sum_j lambda1 * w_j * | beta_j |
  *   where vector y, matrix x and d are specified by linregmodel *lreg,
- *   e.g. y = lreg->y, x = lreg->x and d = lreg->d ***/
+ *   e.g. y = lreg->y, x = lreg->x and d = lreg->pen ***/
 struct s_cdescent {
 
 	bool					was_modified;			// whether this object was modified after created
 
 	/* whether regression type is Lasso */
-	bool					is_regtype_lasso;		// = (d == NULL)
+	bool					is_regtype_lasso;		// = (pen == NULL)
 	bool					use_penalty_factor;		// whether use penalty factor
 	bool					use_intercept;			// whether use intercept (default is true)
 	bool					use_fixed_lambda;		// use fixed lambda value (default is false)
 	CoordinateSelectionRule	rule;					// decide cyclic or stochastic coordinate descent
 
 	const int				*m;						// number of observations, points cd->lreg->y->m
-	const int				*n;						// number of variables, points cd->lreg->x->n
+	const int				*n;						// number of variables, points cd->lreg->prov->n
 	const linregmodel		*lreg;					// linear regression model
 
 
@@ -86,7 +241,7 @@ struct s_cdescent {
 
 	double					tolerance;				// tolerance of convergence
 
-	double					nrm1;					// L1 norm of beta (= sum_j |beta_j|)
+	double					nrm1;					// L1 norm of beta (= sum_j |beta_j|), calculated when each lambda converges
 
 	double					b0;						// intercept
 
@@ -98,8 +253,30 @@ struct s_cdescent {
 	int						maxiter;				// maximum number of iterations
 
 	bool					parallel;				// whether enable parallel calculation
+	bool					row_parallel;			// parallelize each coordinate update over rows of X
+	bool					first_touch;			// beta and mu are placed on NUMA nodes of the owner threads
+
+	/* state shared by the worker team of threads */
+	double					amax_eta;				// max |eta(j)| of current cycle
+	bool					cycle_converged;		// whether current cycle is converged
+	int						npartial;				// size of partial
+	double					*partial;				// partial sums of X(:,j)' * mu of each thread (row_parallel)
+	double					etaj;					// eta(j) broadcasted to the team (row_parallel)
+
+	sampler					*sampler;				// random selection of coordinates
+	acceleration			*acc;					// state of accelerated coordinate descent
+	greedy					*greedy;				// state of greedy coordinate descent
+	block					*block;					// state of block coordinate descent
+	svrg					*svrg;					// state of Prox-SVRG
+	anderson				*aa;					// state of Anderson extrapolation
 
 	constraint_func			cfunc;					// constraint function
+	double					*lower;					// lower bounds of beta of box constraint, or NULL: size n
+	double					*upper;					// upper bounds of beta of box constraint, or NULL: size n
+
+	sweep_func				sweep;					// specialized sweep of serial cyclic rule, or NULL
+
+	workspace				*work;					// preallocated work spaces
 
 	bool					output_fullpath;		// whether to outputs full solution path
 	char					fn_path[128];			// file to output solution path
@@ -135,6 +312,124 @@ typedef enum {
  *
  * this object stores vector y, matrix x, d and their properties
  ***/
+/*** type of the linear operator of penalty D ***/
+typedef enum {
+	PENALTY_MATRIX,		// D is stored in mm_real
+	PENALTY_IDENTITY,	// D = w0 * E
+	PENALTY_STENCIL		// D = [w0 * E; wx * Dx; wy * Dy; wz * Dz] on nx x ny x nz grid, w0 * E is omitted if w0 = 0
+} PenaltyType;
+
+/*** linear operator of penalty D.
+ * The identity and the first-difference stencils are not stored, and D(:,j) is
+ * calculated from the grid index of j-th cell (see penalty.c) ***/
+struct s_penalty {
+	PenaltyType		type;
+
+	int				m;				// number of rows of D
+	int				n;				// number of columns of D
+
+	mm_real			*d;				// PENALTY_MATRIX: D, which is not freed by penalty_free
+
+	int				nx;				// PENALTY_STENCIL: size of the grid
+	int				ny;
+	int				nz;
+	double			w[4];			// w0, wx, wy, wz
+
+	double			*scale;			// implicit D: scale of each column, NULL if not scaled
+};
+
+/*** type of the column provider of X ***/
+typedef enum {
+	PROVIDER_MATRIX,		// X is stored in mm_real, dense or sparse
+	PROVIDER_XMATFILE,		// columns are read from the kernel matrix container through the pool
+	PROVIDER_XMATFILE_MMAP,	// kernel matrix container is mapped into memory
+	PROVIDER_FUNCTION		// columns are calculated on the fly by a function through the pool
+} ProviderType;
+
+/*** function which calculates j-th column of X into xj (size m) for PROVIDER_FUNCTION.
+ * This is called concurrently by the threads for different columns ***/
+typedef void (*provider_column_func) (const int j, double *xj, void *data);
+
+/*** pool of column buffers of X of the out-of-core providers.
+ * Recently used columns are kept resident within the memory budget,
+ * and the least recently used column is replaced on a miss.
+ * A column in use is pinned, so that it is not replaced by other threads.
+ * The following columns can be read ahead by a background thread
+ * (see provider_read_ahead) ***/
+typedef struct s_xjpool	xjpool;
+
+struct s_xjpool {
+	int				nthreads;		// num of threads which have their own buffer
+	double			*buf;			// buffer of each thread: size = m * nthreads
+
+	int				nslots;			// num of column buffers
+	double			*data;			// column buffers: size = m * nslots
+	int				*slot;			// slot of j-th column, or -1 if not resident: size = n
+	int				*owner;			// column stored in k-th slot, or -1: size = nslots
+	int				*pin;			// num of users of k-th slot: size = nslots
+	bool			*loading;		// whether k-th slot is being read: size = nslots
+	int				*prev;			// doubly linked list of slots in order of use,
+	int				*next;			// head is the most recently used: size = nslots
+	int				head;
+	int				tail;
+
+	long			nhits;			// num of accesses served from the pool
+	long			nreads;			// num of columns loaded into the pool or the buffers
+	int				nresident;		// num of columns resident in the pool
+
+	pthread_mutex_t	lock;			// lock of the pool
+	pthread_cond_t	loaded;			// signaled when a slot is loaded
+
+	/* read-ahead by a background thread */
+	int				nahead;			// num of columns read ahead, 0 if not started
+	int				ahead_from;		// first column to read ahead, or -1 if no request
+	bool			ahead_stop;		// request to stop the thread
+	pthread_cond_t	ahead_cond;		// signaled when a request is posted
+	pthread_t		ahead_thread;
+
+	/* work space of the operations on the blocks of X (see provider_xb_trans_dot_y),
+	 * which is kept and enlarged only when a larger block is given */
+	int				xbcols;			// num of columns of the work space
+	double			*xbblock;		// row block of X_B: size = rowblock * xbcols
+	char			*xbraw;			// records of the row block of X_B, NULL if stored in double
+	double			*xbc;			// work: size = xbcols
+};
+
+/*** column provider of X.
+ * The solvers access X only through the operations on its columns (see provider.c),
+ * so that X may be stored in memory, in files, or calculated on the fly ***/
+struct s_provider {
+	ProviderType		type;
+
+	int					m;				// number of rows of X
+	int					n;				// number of columns of X
+
+	mm_real				*x;				// PROVIDER_MATRIX: X, which is not freed by provider_free
+
+	/* PROVIDER_XMATFILE(_MMAP): t-th tile of X is placed at offset + t * tile * reclen
+	 * of the kernel matrix container, which is stored by row blocks (see mm_real_xmatfile_header) */
+	MMRealXmatFormat	format;			// format of the columns in the container
+	size_t				reclen;			// size of a column in the container in bytes
+	size_t				offset;			// offset of the first column in bytes
+	int					tile;			// num of columns of a tile, which are streamed at once by provider_dot_y
+	int					rowblock;		// num of rows of a row block, m if the rows are not divided
+	FILE				*fp;			// container
+	char				*map;			// PROVIDER_XMATFILE_MMAP: mapped container
+	size_t				maplen;			// length of the mapped container in bytes
+
+	/* PROVIDER_FUNCTION */
+	provider_column_func	func;		// function which calculates X(:,j)
+	void				*data;			// data passed to func
+
+	/* statistics of X before the columns were normalized, which are known in advance,
+	 * e.g. stored in the container, or NULL (see linregmodel_new_with_provider) */
+	double				*sx;			// sum X(:,j): size n
+	double				*xtx;			// X(:,j)' * X(:,j): size n
+
+	double				*scale;			// out-of-core X: scale of each column, NULL if not scaled
+	xjpool				*pool;			// out-of-core X: pool of column buffers, NULL for PROVIDER_MATRIX
+};
+
 struct s_linregmodel {
 
 	bool			ycentered;		// y is centered?
@@ -142,8 +437,10 @@ struct s_linregmodel {
 	bool			xnormalized;	// x is normalized?
 
 	mm_dense		*y;				// dense general: observed data vector y (must be dense)
-	mm_real			*x;				// sparse/dense symmetric/general: matrix of predictors x
-	mm_real			*d;				// sparse/dense symmetric/general: linear operator of penalty d
+	mm_real			*x;				// sparse/dense symmetric/general: matrix of predictors x,
+									// NULL if x is not stored in memory
+	provider		*prov;			// column provider of x, which is owned by this object
+	penalty			*pen;			// linear operator of penalty d, NULL if Lasso
 
 	mm_dense		*c;				// = x' * y: correlation (constant) vector
 	double			camax;			// max ( abs (c) )
@@ -0,0 +1,43 @@
+/*
+ * penalty.h
+ *
+ *  linear operator of the quadratic penalty
+ *
+ *  Created on: 2026/10/18
+ *      Author: utsugi
+ */
+
+#ifndef PENALTY_H_
+#define PENALTY_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <mmreal.h>
+#include <objects.h>
+
+/* penalty.c */
+penalty	*penalty_new_matrix (mm_real *d);
+penalty	*penalty_new_identity (const int n, const double w0);
+penalty	*penalty_new_stencil (const int nx, const int ny, const int nz,
+			const double w0, const double wx, const double wy, const double wz);
+penalty	*penalty_copy (const penalty *p);
+void	penalty_free (penalty *p);
+bool	penalty_is_implicit (const penalty *p);
+
+void	penalty_scale_column (penalty *p, const int j, const double alpha);
+
+double	penalty_dj_ssq (const penalty *p, const int j);
+double	penalty_dj_trans_dot_y (const penalty *p, const int j, const mm_dense *y);
+void	penalty_adjpy (const double alpha, const penalty *p, const int j, mm_dense *y);
+void	penalty_adjpy_atomic (const double alpha, const penalty *p, const int j, mm_dense *y);
+void	penalty_dot_y (const bool trans, const double alpha, const penalty *p, const mm_dense *y,
+			const double beta, mm_dense *z);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PENALTY_H_ */
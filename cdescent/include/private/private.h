@@ -9,6 +9,8 @@
 #define PRIVATE_H
 
 #include <float.h>
+#include <stddef.h>
+#include <mmreal.h>
 
 /* private macros, constants and headers
  * which are only used internally */
@@ -54,5 +56,17 @@ extern const double	dmone;	// -1.
 void	error_and_exit (const char * function_name, const char *error_msg, const char *file, const int line);
 /* print warning message */
 void	printf_warning (const char * function_name, const char *error_msg, const char *file, const int line);
+/* range of indices assigned to a thread by the static schedule */
+void	static_partition (const int n, const int nth, const int tid, int *start, int *len);
+/* y = alpha * x + y and return z' * y of updated y in one pass over y */
+double	axpy_dot (const int n, const double alpha, const double *x, const double *z, double *y);
+/* malloc, calloc and realloc of the work spaces of the solvers, which are counted */
+void	*work_malloc (const size_t size);
+void	*work_calloc (const size_t nmemb, const size_t size);
+void	*work_realloc (void *ptr, const size_t size);
+/* num of work spaces allocated so far */
+long	work_num_allocated (void);
+/* new dense vector of size n, which is set to 0 */
+mm_dense	*vector_new (const int n);
 
 #endif /* PRIVATE_H */
@@ -0,0 +1,25 @@
+/*
+ * random.h
+ *
+ *  Created on: 2026/10/18
+ *      Author: utsugi
+ */
+
+#ifndef PRIVATE_RANDOM_H
+#define PRIVATE_RANDOM_H
+
+#include <stdint.h>
+
+/* state of xoshiro256** pseudo random number generator */
+struct s_xoshiro256 {
+	uint64_t	s[4];
+};
+
+typedef struct s_xoshiro256	xoshiro256;
+
+void		xoshiro256_init (xoshiro256 *rng, const uint64_t seed);
+uint64_t	xoshiro256_next (xoshiro256 *rng);
+int			xoshiro256_int (xoshiro256 *rng, const int n);
+double		xoshiro256_double (xoshiro256 *rng);
+
+#endif /* PRIVATE_RANDOM_H */
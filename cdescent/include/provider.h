@@ -0,0 +1,53 @@
+/*
+ * provider.h
+ *
+ *  column provider of the matrix of predictors X
+ *
+ *  Created on: 2026/10/19
+ *      Author: utsugi
+ */
+
+#ifndef PROVIDER_H_
+#define PROVIDER_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <mmreal.h>
+#include <objects.h>
+
+/* provider.c */
+provider	*provider_new_matrix (mm_real *x);
+provider	*provider_new_xmatfile (const char *fn, const size_t budget);
+provider	*provider_new_xmatfile_mmap (const char *fn);
+provider	*provider_new_function (const int m, const int n, provider_column_func func, void *data, const size_t budget);
+void		provider_free (provider *p);
+bool		provider_is_in_core (const provider *p);
+
+void		provider_read_ahead (provider *p, const int nahead);
+void		provider_advise (const provider *p, const bool sequential);
+void		provider_willneed (const provider *p, const int j);
+long		provider_num_reads (const provider *p);
+long		provider_num_hits (const provider *p);
+
+void		provider_scale_column (provider *p, const int j, const double alpha);
+
+double		provider_xj_sum (const provider *p, const int j);
+double		provider_xj_ssq (const provider *p, const int j);
+double		provider_xj_trans_dot_y (const provider *p, const int j, const mm_dense *y);
+void		provider_axjpy (const double alpha, const provider *p, const int j, mm_dense *y);
+void		provider_axjpy_atomic (const double alpha, const provider *p, const int j, mm_dense *y);
+void		provider_dot_y (const bool trans, const double alpha, const provider *p, const mm_dense *y,
+				const double beta, mm_dense *z);
+
+bool		provider_has_blocks (const provider *p);
+void		provider_xb_trans_dot_y (const provider *p, const int j0, const int nb, const mm_dense *y, double *z);
+void		provider_xb_dot_etapy (const provider *p, const int j0, const int nb, const double *eta, mm_dense *y);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PROVIDER_H_ */
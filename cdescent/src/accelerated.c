@@ -0,0 +1,235 @@
+/*
+ * accelerated.c
+ *
+ *  Created on: 2026/10/18
+ *      Author: utsugi
+ */
+
+#include <stdlib.h>
+#include <math.h>
+#include <cdescent.h>
+#include <mmreal.h>
+
+#include "private/private.h"
+
+/* update.c */
+extern void		update_intercept (cdescent *cd);
+extern double	cdescent_update_z (cdescent *cd, int j, const double xjy, const double djy, const double ntheta);
+/* sampler.c */
+extern int		*cdescent_random_permutation (cdescent *cd);
+/* regression.c */
+extern double	cdescent_objective (const cdescent *cd);
+
+/* upper limit of the number of cycles between the fixed restarts */
+#define ACCELERATION_MAX_RESTART_CYCLES	64
+
+/* allocate acceleration object */
+static acceleration *
+acceleration_alloc (void)
+{
+	acceleration	*acc = (acceleration *) malloc (sizeof (acceleration));
+	if (acc == NULL) return NULL;
+
+	acc->restart = true;
+	acc->ncycles = 0;
+	acc->period = 0;
+	acc->theta = 0.;
+	acc->lambda = 0.;
+	acc->obj = 0.;
+
+	acc->z = NULL;
+	acc->xz = NULL;
+	acc->dz = NULL;
+	acc->u = NULL;
+	acc->xu = NULL;
+	acc->du = NULL;
+
+	return acc;
+}
+
+/*** create new acceleration object for cd ***/
+acceleration *
+acceleration_new (const cdescent *cd)
+{
+	acceleration	*acc = acceleration_alloc ();
+	if (acc == NULL) error_and_exit ("acceleration_new", "failed to allocate object.", __FILE__, __LINE__);
+
+	acc->z = vector_new (*cd->n);
+	acc->xz = vector_new (*cd->m);
+	acc->u = vector_new (*cd->n);
+	acc->xu = vector_new (*cd->m);
+	if (!cd->is_regtype_lasso) {
+		acc->dz = vector_new (cd->lreg->pen->m);
+		acc->du = vector_new (cd->lreg->pen->m);
+	}
+	return acc;
+}
+
+/*** free acceleration object ***/
+void
+acceleration_free (acceleration *acc)
+{
+	if (acc) {
+		if (acc->z) mm_real_free (acc->z);
+		if (acc->xz) mm_real_free (acc->xz);
+		if (acc->dz) mm_real_free (acc->dz);
+		if (acc->u) mm_real_free (acc->u);
+		if (acc->xu) mm_real_free (acc->xu);
+		if (acc->du) mm_real_free (acc->du);
+		free (acc);
+	}
+	return;
+}
+
+/* number of cycles between the fixed restarts (O'Donoghue and Candes, 2015).
+ * The problem is strongly convex if lambda2 > 0, where coordinate descent converges linearly,
+ * but theta of APPROX decreases as O(1 / k) and the momentum prevents the linear convergence.
+ * The optimal period is O(sqrt(kappa)) cycles, where kappa = (1 + lambda2) / lambda2 is the condition
+ * number of the coordinates of normalized X if the strong convexity is given only by lambda2 */
+static int
+restart_period (const cdescent *cd)
+{
+	double	period;
+	if (cd->lambda2 <= 0.) return ACCELERATION_MAX_RESTART_CYCLES;
+	period = ceil (sqrt ((1. + cd->lambda2) / cd->lambda2));
+	return (period < ACCELERATION_MAX_RESTART_CYCLES) ? (int) period : ACCELERATION_MAX_RESTART_CYCLES;
+}
+
+/* restart the sequences from current beta: z = beta, u = 0 and theta = 1 / n */
+static void
+restart (cdescent *cd)
+{
+	acceleration	*acc = cd->acc;
+
+	mm_real_memcpy (acc->z, cd->beta);
+	mm_real_memcpy (acc->xz, cd->mu);
+	mm_real_set_all (acc->u, 0.);
+	mm_real_set_all (acc->xu, 0.);
+	if (!cd->is_regtype_lasso) {
+		mm_real_memcpy (acc->dz, cd->nu);
+		mm_real_set_all (acc->du, 0.);
+	}
+	acc->theta = 1. / (double) *cd->n;
+	acc->ncycles = 0;
+	acc->period = restart_period (cd);
+	acc->lambda = cd->lambda;
+	acc->obj = cdescent_objective (cd);
+	acc->restart = false;
+	return;
+}
+
+/* swap *a <-> *b */
+static void
+swap_vectors (mm_dense **a, mm_dense **b)
+{
+	mm_dense	*tmp = *a;
+	*a = *b;
+	*b = tmp;
+	return;
+}
+
+/* z, X * z and D * z are placed on cd->beta, cd->mu and cd->nu during the sweep,
+ * so that the step-size calculation and the constraint function see z.
+ * Calling this twice restores the original placement */
+static void
+swap_z_and_beta (cdescent *cd)
+{
+	swap_vectors (&cd->beta, &cd->acc->z);
+	swap_vectors (&cd->mu, &cd->acc->xz);
+	if (!cd->is_regtype_lasso) swap_vectors (&cd->nu, &cd->acc->dz);
+	return;
+}
+
+/* y(:) = alpha * x(:) + z(:) */
+static void
+set_axpz (const double alpha, const mm_dense *x, const mm_dense *z, mm_dense *y)
+{
+	mm_real_memcpy (y, z);
+	daxpy_ (&y->nnz, &alpha, x->data, &ione, y->data, &ione);
+	return;
+}
+
+/*** progress accelerated randomized coordinate descent (APPROX) for one full cycle,
+ * i.e. n updates of randomly selected coordinates.
+ * Each update of z(j) minimizes the quadratic model at y = theta^2 * u + z
+ * whose curvature is inflated by n * theta, then u(j) -= (1 - n * theta) / theta^2 * t(j),
+ * and theta is decreased as theta_new = (sqrt(theta^4 + 4 theta^2) - theta^2) / 2.
+ * At the end of cycle, the solution beta = theta^2 * u + z and mu, nu are formed explicitly.
+ * The coordinates of one cycle are drawn without replacement, so that every coordinate
+ * is visited in each cycle and the convergence test max |eta| < tolerance is meaningful.
+ * If the objective function is increased, the sequences are restarted from beta
+ * (adaptive restart, O'Donoghue and Candes, 2015), and they are restarted
+ * every restart_period cycles in any case ***/
+bool
+cdescent_do_update_once_cycle_accelerated (cdescent *cd)
+{
+#pragma omp single
+	{
+		int				k;
+		int				n = *cd->n;
+		const int		*index;
+		double			theta2 = 0.;
+		double			obj;
+		acceleration	*acc = cd->acc;
+
+		/* b = (sum(y) - sum(X) * beta) / m */
+		if (cd->use_intercept) update_intercept (cd);
+
+		// sequences are (re)started at new lambda
+		if (acc->restart || acc->lambda != cd->lambda) restart (cd);
+
+		index = cdescent_random_permutation (cd);
+
+		swap_z_and_beta (cd);
+		for (k = 0; k < n; k++) {
+			int		j = index[k];
+			double	ntheta = (double) n * acc->theta;
+			// X(:,j)' * X * y and D(:,j)' * D * y at y = theta^2 * u + z
+			double	xjy, djy = 0.;
+			double	tj;
+
+			theta2 = acc->theta * acc->theta;
+			xjy = provider_xj_trans_dot_y (cd->lreg->prov, j, cd->mu)
+				+ theta2 * provider_xj_trans_dot_y (cd->lreg->prov, j, acc->xu);
+			if (!cd->is_regtype_lasso)
+				djy = penalty_dj_trans_dot_y (cd->lreg->pen, j, cd->nu)
+					+ theta2 * penalty_dj_trans_dot_y (cd->lreg->pen, j, acc->du);
+
+			// z(j) += t(j)
+			tj = cdescent_update_z (cd, j, xjy, djy, ntheta);
+			if (tj != 0. && ntheta < 1.) {
+				// u(j) -= (1 - n * theta) / theta^2 * t(j)
+				double	uj = - (1. - ntheta) / theta2 * tj;
+				acc->u->data[j] += uj;
+				provider_axjpy (uj, cd->lreg->prov, j, acc->xu);
+				if (!cd->is_regtype_lasso) penalty_adjpy (uj, cd->lreg->pen, j, acc->du);
+			}
+			acc->theta = 0.5 * (sqrt (theta2 * theta2 + 4. * theta2) - theta2);
+		}
+		swap_z_and_beta (cd);
+
+		/* beta_new = theta^2 * u + z, where theta is that of the last update */
+		cd->amax_eta = 0.;
+		for (k = 0; k < n; k++) {
+			double	betaj = theta2 * acc->u->data[k] + acc->z->data[k];
+			double	abs_etaj = fabs (betaj - cd->beta->data[k]);
+			if (cd->amax_eta < abs_etaj) cd->amax_eta = abs_etaj;
+			cd->beta->data[k] = betaj;
+		}
+		set_axpz (theta2, acc->xu, acc->xz, cd->mu);
+		if (!cd->is_regtype_lasso) set_axpz (theta2, acc->du, acc->dz, cd->nu);
+
+		// adaptive restart
+		obj = cdescent_objective (cd);
+		if (obj > acc->obj) acc->restart = true;
+		acc->obj = obj;
+		// fixed restart
+		if (++acc->ncycles >= acc->period) acc->restart = true;
+
+		if (!cd->was_modified) cd->was_modified = true;
+
+		cd->cycle_converged = (cd->amax_eta < cd->tolerance);
+	}
+
+	return cd->cycle_converged;
+}
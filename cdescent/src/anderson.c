@@ -0,0 +1,262 @@
+/*
+ * anderson.c
+ *
+ *  Created on: 2026/10/18
+ *      Author: utsugi
+ */
+
+#include <stdlib.h>
+#include <math.h>
+#include <cdescent.h>
+#include <mmreal.h>
+
+#include "private/private.h"
+
+/* regression.c */
+extern double	cdescent_objective (const cdescent *cd);
+
+/* allocate anderson object */
+static anderson *
+anderson_alloc (void)
+{
+	anderson	*aa = (anderson *) malloc (sizeof (anderson));
+	if (aa == NULL) return NULL;
+
+	aa->k = 0;
+	aa->count = 0;
+
+	aa->beta = NULL;
+	aa->mu = NULL;
+	aa->nu = NULL;
+
+	aa->u = NULL;
+	aa->utu = NULL;
+	aa->c = NULL;
+
+	aa->ebeta = NULL;
+	aa->emu = NULL;
+	aa->enu = NULL;
+
+	return aa;
+}
+
+/* create new m x n dense matrix */
+static mm_dense *
+matrix_new (const int m, const int n)
+{
+	return mm_real_new (MM_REAL_DENSE, MM_REAL_GENERAL, m, n, m * n);
+}
+
+/*** create new anderson object for cd which extrapolates every k sweeps ***/
+anderson *
+anderson_new (const cdescent *cd, const int k)
+{
+	anderson	*aa = anderson_alloc ();
+	if (aa == NULL) error_and_exit ("anderson_new", "failed to allocate object.", __FILE__, __LINE__);
+
+	aa->k = k;
+
+	aa->beta = matrix_new (*cd->n, k + 1);
+	aa->mu = matrix_new (*cd->m, k + 1);
+	aa->u = matrix_new (*cd->n, k);
+	aa->ebeta = matrix_new (*cd->n, 1);
+	aa->emu = matrix_new (*cd->m, 1);
+	if (!cd->is_regtype_lasso) {
+		aa->nu = matrix_new (cd->lreg->pen->m, k + 1);
+		aa->enu = matrix_new (cd->lreg->pen->m, 1);
+	}
+
+	aa->utu = (double *) malloc (k * k * sizeof (double));
+	aa->c = (double *) malloc (k * sizeof (double));
+	if (aa->utu == NULL || aa->c == NULL) error_and_exit ("anderson_new", "cannot allocate memory.", __FILE__, __LINE__);
+
+	return aa;
+}
+
+/*** free anderson object ***/
+void
+anderson_free (anderson *aa)
+{
+	if (aa) {
+		if (aa->beta) mm_real_free (aa->beta);
+		if (aa->mu) mm_real_free (aa->mu);
+		if (aa->nu) mm_real_free (aa->nu);
+		if (aa->u) mm_real_free (aa->u);
+		if (aa->utu) free (aa->utu);
+		if (aa->c) free (aa->c);
+		if (aa->ebeta) mm_real_free (aa->ebeta);
+		if (aa->emu) mm_real_free (aa->emu);
+		if (aa->enu) mm_real_free (aa->enu);
+		free (aa);
+	}
+	return;
+}
+
+/* copy vector x to the l-th column of matrix a */
+static void
+store_column (mm_dense *a, const int l, const mm_dense *x)
+{
+	dcopy_ (&a->m, x->data, &ione, a->data + (size_t) l * a->m, &ione);
+	return;
+}
+
+/* x = a(:, 1:k) * c (the 0-th column of a is not used) */
+static void
+combine_columns (const mm_dense *a, const int k, const double *c, mm_dense *x)
+{
+	dgemv_ ("N", &a->m, &k, &done, a->data + a->m, &a->m, c, &ione, &dzero, x->data, &ione);
+	return;
+}
+
+/* solve a * x = b by Gaussian elimination with partial pivoting,
+ * where a is k x k and overwritten. Return false if a is (nearly) singular */
+static bool
+solve (const int k, double *a, double *b)
+{
+	int		i, j, l;
+	double	amax = 0.;
+
+	for (i = 0; i < k * k; i++) if (amax < fabs (a[i])) amax = fabs (a[i]);
+	if (amax <= 0.) return false;
+
+	for (l = 0; l < k; l++) {
+		int		p = l;
+		for (i = l + 1; i < k; i++) if (fabs (a[i + l * k]) > fabs (a[p + l * k])) p = i;
+		if (fabs (a[p + l * k]) < DBL_EPSILON * amax) return false;
+		if (p != l) {
+			double	tmp;
+			for (j = 0; j < k; j++) {
+				tmp = a[l + j * k];
+				a[l + j * k] = a[p + j * k];
+				a[p + j * k] = tmp;
+			}
+			tmp = b[l];
+			b[l] = b[p];
+			b[p] = tmp;
+		}
+		for (i = l + 1; i < k; i++) {
+			double	f = a[i + l * k] / a[l + l * k];
+			for (j = l + 1; j < k; j++) a[i + j * k] -= f * a[l + j * k];
+			b[i] -= f * b[l];
+		}
+	}
+	for (l = k - 1; l >= 0; l--) {
+		for (j = l + 1; j < k; j++) b[l] -= a[l + j * k] * b[j];
+		b[l] /= a[l + l * k];
+	}
+	return true;
+}
+
+/* swap cd->beta, mu and nu with the extrapolated ones */
+static void
+swap_extrapolated (cdescent *cd)
+{
+	anderson	*aa = cd->aa;
+	mm_dense	*tmp;
+
+	tmp = cd->beta;
+	cd->beta = aa->ebeta;
+	aa->ebeta = tmp;
+
+	tmp = cd->mu;
+	cd->mu = aa->emu;
+	aa->emu = tmp;
+
+	if (!cd->is_regtype_lasso) {
+		tmp = cd->nu;
+		cd->nu = aa->enu;
+		aa->enu = tmp;
+	}
+	return;
+}
+
+/* whether the extrapolated beta satisfies the constraint */
+static bool
+is_feasible (cdescent *cd)
+{
+	int		j;
+	double	val;
+	if (!cd->cfunc) return true;
+	for (j = 0; j < *cd->n; j++) {
+		double	etaj = cd->aa->ebeta->data[j] - cd->beta->data[j];
+		if (!cd->cfunc (cd, j, etaj, &val)) return false;
+	}
+	return true;
+}
+
+/* extrapolate the stored k + 1 iterates beta_0, ..., beta_k:
+ * beta_e = sum_l c(l) * beta_(l + 1), where c = z / sum(z), (U' * U) * z = 1,
+ * U = [beta_1 - beta_0, ..., beta_k - beta_(k - 1)].
+ * mu and nu are extrapolated by the same coefficients.
+ * If the extrapolated point is feasible and decreases the objective function,
+ * it is replaced with current beta, mu and nu, and true is returned */
+static bool
+extrapolate (cdescent *cd)
+{
+	int			l;
+	int			n = *cd->n;
+	anderson	*aa = cd->aa;
+	int			k = aa->k;
+	double		sum = 0.;
+	double		obj;
+
+	// U(:,l) = beta_(l+1) - beta_l
+	for (l = 0; l < k; l++) {
+		double	*ul = aa->u->data + (size_t) l * n;
+		dcopy_ (&n, aa->beta->data + (size_t) (l + 1) * n, &ione, ul, &ione);
+		daxpy_ (&n, &dmone, aa->beta->data + (size_t) l * n, &ione, ul, &ione);
+	}
+	// U' * U
+	dgemm_ ("T", "N", &k, &k, &n, &done, aa->u->data, &n, aa->u->data, &n, &dzero, aa->utu, &k);
+
+	for (l = 0; l < k; l++) aa->c[l] = 1.;
+	if (!solve (k, aa->utu, aa->c)) return false;
+	for (l = 0; l < k; l++) sum += aa->c[l];
+	if (fabs (sum) < DBL_EPSILON) return false;
+	for (l = 0; l < k; l++) aa->c[l] /= sum;
+
+	combine_columns (aa->beta, k, aa->c, aa->ebeta);
+	if (!is_feasible (cd)) return false;
+	combine_columns (aa->mu, k, aa->c, aa->emu);
+	if (!cd->is_regtype_lasso) combine_columns (aa->nu, k, aa->c, aa->enu);
+
+	obj = cdescent_objective (cd);
+	swap_extrapolated (cd);
+	if (cdescent_objective (cd) < obj) return true;
+
+	// objective function was not decreased, falls back to the plain iterate
+	swap_extrapolated (cd);
+	return false;
+}
+
+/*** clear the stored iterates, e.g. when lambda is changed ***/
+void
+cdescent_anderson_reset (cdescent *cd)
+{
+	cd->aa->count = 0;
+	return;
+}
+
+/*** store current beta, mu and nu after a sweep,
+ * and every k sweeps, try to extrapolate them.
+ * The resulting beta (extrapolated or not) starts the next k sweeps ***/
+void
+cdescent_anderson_update (cdescent *cd)
+{
+	anderson	*aa = cd->aa;
+
+	store_column (aa->beta, aa->count, cd->beta);
+	store_column (aa->mu, aa->count, cd->mu);
+	if (!cd->is_regtype_lasso) store_column (aa->nu, aa->count, cd->nu);
+	if (++aa->count <= aa->k) return;
+
+	// sequences of accelerated coordinate descent no longer match beta
+	if (extrapolate (cd) && cd->acc) cd->acc->restart = true;
+
+	// current beta, i.e. extrapolated one or the last iterate, is moved to the head
+	store_column (aa->beta, 0, cd->beta);
+	store_column (aa->mu, 0, cd->mu);
+	if (!cd->is_regtype_lasso) store_column (aa->nu, 0, cd->nu);
+	aa->count = 1;
+	return;
+}
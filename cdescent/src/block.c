@@ -0,0 +1,222 @@
+/*
+ * block.c
+ *
+ *  Created on: 2026/10/18
+ *      Author: utsugi
+ */
+
+#include <stdlib.h>
+#include <math.h>
+#include <cdescent.h>
+#include <mmreal.h>
+
+#include "private/private.h"
+
+/* update.c */
+extern void		update_intercept (cdescent *cd);
+/* stepsize.c */
+extern double	cdescent_scale2 (const cdescent *cd, const int j);
+extern double	cdescent_beta_stepsize_block (const cdescent *cd, const int j, const double xjmu, const double djnu,
+					const double lip);
+
+/* allocate block object */
+static block *
+block_alloc (void)
+{
+	block	*blk = (block *) malloc (sizeof (block));
+	if (blk == NULL) return NULL;
+
+	blk->size = 0;
+	blk->nblocks = 0;
+
+	blk->lx = NULL;
+	blk->ld = NULL;
+
+	blk->xmu = NULL;
+	blk->dnu = NULL;
+	blk->eta = NULL;
+
+	blk->xeta = NULL;
+	blk->deta = NULL;
+
+	return blk;
+}
+
+/*** create new block object, which divides the coordinates of cd into blocks of
+ * size consecutive columns of X. X must be dense general, or stored in the
+ * kernel matrix container (see provider_has_blocks) ***/
+block *
+block_new (const cdescent *cd, const int size)
+{
+	int		j, k;
+	int		n = *cd->n;
+	block	*blk;
+
+	if (size <= 0) error_and_exit ("block_new", "size of block must be > 0.", __FILE__, __LINE__);
+	if (!provider_has_blocks (cd->lreg->prov))
+		error_and_exit ("block_new", "X must be dense general or stored in xmat file.", __FILE__, __LINE__);
+
+	blk = block_alloc ();
+	if (blk == NULL) error_and_exit ("block_new", "failed to allocate object.", __FILE__, __LINE__);
+
+	blk->size = (size < n) ? size : n;
+	blk->nblocks = (n + blk->size - 1) / blk->size;
+
+	blk->lx = (double *) malloc (blk->nblocks * sizeof (double));
+	blk->ld = (double *) malloc (blk->nblocks * sizeof (double));
+	blk->xmu = (double *) malloc (blk->size * sizeof (double));
+	blk->dnu = (double *) malloc (blk->size * sizeof (double));
+	blk->eta = (double *) malloc (blk->size * sizeof (double));
+	if (blk->lx == NULL || blk->ld == NULL || blk->xmu == NULL || blk->dnu == NULL || blk->eta == NULL)
+		error_and_exit ("block_new", "cannot allocate memory.", __FILE__, __LINE__);
+
+	/* the Lipschitz constants start from the largest diagonal elements of X_B' * X_B and D_B' * D_B,
+	 * which are lower bounds of them, and are increased by update_block when they are exceeded */
+	for (k = 0; k < blk->nblocks; k++) {
+		int		j0 = k * blk->size;
+		int		nb = (j0 + blk->size <= n) ? blk->size : n - j0;
+		blk->lx[k] = 0.;
+		blk->ld[k] = 0.;
+		for (j = j0; j < j0 + nb; j++) {
+			double	xtxj = (cd->lreg->xnormalized) ? 1. : cd->lreg->xtx[j];
+			if (blk->lx[k] < xtxj) blk->lx[k] = xtxj;
+			if (!cd->is_regtype_lasso && blk->ld[k] < cd->lreg->dtd[j]) blk->ld[k] = cd->lreg->dtd[j];
+		}
+	}
+
+	blk->xeta = mm_real_new (MM_REAL_DENSE, MM_REAL_GENERAL, *cd->m, 1, *cd->m);
+	if (!cd->is_regtype_lasso)
+		blk->deta = mm_real_new (MM_REAL_DENSE, MM_REAL_GENERAL, cd->lreg->pen->m, 1, cd->lreg->pen->m);
+
+	return blk;
+}
+
+/*** free block object ***/
+void
+block_free (block *blk)
+{
+	if (blk) {
+		if (blk->lx) free (blk->lx);
+		if (blk->ld) free (blk->ld);
+		if (blk->xmu) free (blk->xmu);
+		if (blk->dnu) free (blk->dnu);
+		if (blk->eta) free (blk->eta);
+		if (blk->xeta) mm_real_free (blk->xeta);
+		if (blk->deta) mm_real_free (blk->deta);
+		free (blk);
+	}
+	return;
+}
+
+/* update k-th block B = [j0, j0 + nb) by a proximal gradient step.
+ * The gradient X_B' * mu is calculated by one pass over X_B, all the coordinates of the block
+ * are moved at once by the proximal step of size 1 / L, then mu += X_B * eta_B by another pass.
+ * Each pass is one dgemv if X is in memory, or one dgemv for each row block of X_B
+ * if X is in the container (see provider_xb_trans_dot_y).
+ * L = lx + lambda2 * ld is a Lipschitz constant of the gradient over the block.
+ * If |X_B * eta_B|^2 > lx * |eta_B|^2 (or the same for D), the step may not decrease the
+ * objective, so lx (or ld) is increased and the step is taken again from the same gradient */
+static void
+update_block (cdescent *cd, const int k)
+{
+	int			i;
+	block		*blk = cd->block;
+	int			j0 = k * blk->size;
+	int			nb = (j0 + blk->size <= *cd->n) ? blk->size : *cd->n - j0;
+	double		nrm2;
+	double		xnrm2;
+	double		dnrm2 = 0.;
+
+	// X_B' * mu
+	provider_xb_trans_dot_y (cd->lreg->prov, j0, nb, cd->mu, blk->xmu);
+	// D_B' * nu
+	if (!cd->is_regtype_lasso) {
+		for (i = 0; i < nb; i++) blk->dnu[i] = penalty_dj_trans_dot_y (cd->lreg->pen, j0 + i, cd->nu);
+	}
+
+	while (1) {
+		double	lip = blk->lx[k];
+		if (!cd->is_regtype_lasso) lip += cd->lambda2 * blk->ld[k];
+
+		nrm2 = 0.;
+		for (i = 0; i < nb; i++) {
+			int		j = j0 + i;
+			double	val;
+			double	etaj = cdescent_beta_stepsize_block (cd, j, blk->xmu[i],
+				(cd->is_regtype_lasso) ? 0. : blk->dnu[i], lip);
+
+			// constraint coordinate descent, same as update_betaj of update.c
+			if (cd->cfunc && !cd->cfunc (cd, j, etaj, &val)) etaj = val - cd->beta->data[j];
+			if (fabs (etaj) < DBL_EPSILON) etaj = 0.;
+			blk->eta[i] = etaj;
+			nrm2 += etaj * etaj;
+		}
+		if (nrm2 == 0.) return;
+
+		// X_B * eta_B
+		mm_real_set_all (blk->xeta, 0.);
+		provider_xb_dot_etapy (cd->lreg->prov, j0, nb, blk->eta, blk->xeta);
+		xnrm2 = ddot_ (&blk->xeta->m, blk->xeta->data, &ione, blk->xeta->data, &ione);
+		// D_B * eta_B
+		if (!cd->is_regtype_lasso) {
+			mm_real_set_all (blk->deta, 0.);
+			for (i = 0; i < nb; i++) {
+				if (blk->eta[i] != 0.) penalty_adjpy (blk->eta[i], cd->lreg->pen, j0 + i, blk->deta);
+			}
+			dnrm2 = ddot_ (&blk->deta->m, blk->deta->data, &ione, blk->deta->data, &ione);
+		}
+
+		if (xnrm2 <= blk->lx[k] * nrm2 && dnrm2 <= blk->ld[k] * nrm2) break;
+
+		// the Lipschitz constants are at least doubled, so that this loop ends in a few steps
+		if (xnrm2 > blk->lx[k] * nrm2) blk->lx[k] = (2. * blk->lx[k] > xnrm2 / nrm2) ? 2. * blk->lx[k] : xnrm2 / nrm2;
+		if (dnrm2 > blk->ld[k] * nrm2) blk->ld[k] = (2. * blk->ld[k] > dnrm2 / nrm2) ? 2. * blk->ld[k] : dnrm2 / nrm2;
+	}
+
+	for (i = 0; i < nb; i++) {
+		int		j = j0 + i;
+		double	etaj = blk->eta[i];
+		double	lip = blk->lx[k];
+		if (etaj == 0.) continue;
+		if (!cd->is_regtype_lasso) lip += cd->lambda2 * blk->ld[k];
+
+		cd->beta->data[j] += etaj;
+
+		/* the step of the block is smaller than that of coordinate descent by scale2 / L,
+		 * so the convergence is checked by the step scaled to that of coordinate descent */
+		etaj *= lip / cdescent_scale2 (cd, j);
+		if (cd->amax_eta < fabs (etaj)) cd->amax_eta = fabs (etaj);
+	}
+
+	// mu += X_B * eta_B
+	daxpy_ (&blk->xeta->m, &done, blk->xeta->data, &ione, cd->mu->data, &ione);
+	// nu += D_B * eta_B
+	if (!cd->is_regtype_lasso) daxpy_ (&blk->deta->m, &done, blk->deta->data, &ione, cd->nu->data, &ione);
+	return;
+}
+
+/*** progress block coordinate descent for one full cycle.
+ * The blocks of consecutive columns are updated in order, each by one proximal gradient step,
+ * which replaces the level-1 BLAS calls for each column with two passes over the block,
+ * so that X stored in the container is read by the row blocks of its tiles.
+ * The iterates differ from those of cyclic coordinate descent, but converge to the same solution ***/
+bool
+cdescent_do_update_once_cycle_block (cdescent *cd)
+{
+#pragma omp single
+	{
+		int		k;
+
+		/* b = (sum(y) - sum(X) * beta) / m */
+		if (cd->use_intercept) update_intercept (cd);
+
+		cd->amax_eta = 0.;
+		for (k = 0; k < cd->block->nblocks; k++) update_block (cd, k);
+
+		if (!cd->was_modified) cd->was_modified = true;
+
+		cd->cycle_converged = (cd->amax_eta < cd->tolerance);
+	}
+
+	return cd->cycle_converged;
+}
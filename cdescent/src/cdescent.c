@@ -12,6 +12,25 @@
 
 #include "private/private.h"
 
+/* sampler.c */
+extern sampler		*sampler_new (const cdescent *cd, const unsigned int seed);
+extern void			sampler_free (sampler *s);
+/* accelerated.c */
+extern acceleration	*acceleration_new (const cdescent *cd);
+extern void			acceleration_free (acceleration *acc);
+/* greedy.c */
+extern greedy		*greedy_new (const cdescent *cd, const int ncache);
+extern void			greedy_free (greedy *g);
+/* block.c */
+extern block		*block_new (const cdescent *cd, const int size);
+extern void			block_free (block *blk);
+/* svrg.c */
+extern svrg			*svrg_new (const cdescent *cd, const int batch);
+extern void			svrg_free (svrg *s);
+/* anderson.c */
+extern anderson		*anderson_new (const cdescent *cd, const int k);
+extern void			anderson_free (anderson *aa);
+
 // default file to output solution path
 static const char	default_fn_path[] = "beta_path.data";
 
@@ -61,9 +80,30 @@ cdescent_alloc (void)
 	cd->nu = NULL;
 
 	cd->parallel = false;
+	cd->row_parallel = false;
+	cd->first_touch = false;
+
+	cd->amax_eta = 0.;
+	cd->cycle_converged = false;
+	cd->npartial = 0;
+	cd->partial = NULL;
+	cd->etaj = 0.;
+
+	cd->sampler = NULL;
+	cd->acc = NULL;
+	cd->greedy = NULL;
+	cd->block = NULL;
+	cd->svrg = NULL;
+	cd->aa = NULL;
 	cd->total_iter = 0;
 
 	cd->cfunc = NULL;
+	cd->lower = NULL;
+	cd->upper = NULL;
+
+	cd->sweep = NULL;
+
+	cd->work = NULL;
 
 	cd->log10_lambda_upper = 0.;
 	cd->log10_lambda_lower = 0.;
@@ -78,6 +118,29 @@ cdescent_alloc (void)
 	return cd;
 }
 
+/* create new workspace object for cd */
+static workspace *
+workspace_new (const cdescent *cd)
+{
+	workspace	*work = (workspace *) malloc (sizeof (workspace));
+	if (work == NULL) return NULL;
+	work->beta = mm_real_new (MM_REAL_DENSE, MM_REAL_GENERAL, *cd->n, 1, *cd->n);
+	work->r = mm_real_new (MM_REAL_DENSE, MM_REAL_GENERAL, *cd->m, 1, *cd->m);
+	return work;
+}
+
+/* free workspace object */
+static void
+workspace_free (workspace *work)
+{
+	if (work) {
+		if (work->beta) mm_real_free (work->beta);
+		if (work->r) mm_real_free (work->r);
+		free (work);
+	}
+	return;
+}
+
 /*** create new cdescent object ***/
 cdescent *
 cdescent_new (const double alpha, const linregmodel *lreg, const double tol, const int maxiter, bool parallel)
@@ -94,15 +157,15 @@ cdescent_new (const double alpha, const linregmodel *lreg, const double tol, con
 
 	cd->lreg = lreg;
 	cd->m = &cd->lreg->y->m;
-	cd->n = &cd->lreg->x->n;
+	cd->n = &cd->lreg->prov->n;
 
 	cd->tolerance = tol;
 
 	cd->alpha1 = alpha;
 	cd->alpha2 = 1. - alpha;
 
-	/* if cd->lreg->d == NULL, regression type is Lasso */
-	cd->is_regtype_lasso =  (cd->lreg->d == NULL);
+	/* if cd->lreg->pen == NULL, regression type is Lasso */
+	cd->is_regtype_lasso =  (cd->lreg->pen == NULL);
 
 	cd->lambda = (cd->alpha1 > 0.) ? cd->lreg->camax / cd->alpha1 : cd->lreg->camax;
 	cd->lambda1 = cd->alpha1 * cd->lambda;
@@ -117,10 +180,14 @@ cdescent_new (const double alpha, const linregmodel *lreg, const double tol, con
 
 	// nu = D * beta
 	if (!cd->is_regtype_lasso) {
-		cd->nu = mm_real_new (MM_REAL_DENSE, MM_REAL_GENERAL, cd->lreg->d->m, 1, cd->lreg->d->m);
+		cd->nu = mm_real_new (MM_REAL_DENSE, MM_REAL_GENERAL, cd->lreg->pen->m, 1, cd->lreg->pen->m);
 		mm_real_set_all (cd->nu, 0.);	// in initial, set to 0
 	}
 
+	// work spaces used in every cycle
+	cd->work = workspace_new (cd);
+	if (cd->work == NULL) error_and_exit ("cdescent_new", "failed to allocate workspace.", __FILE__, __LINE__);
+
 	cd->maxiter = maxiter;
 	cd->parallel = parallel;
 
@@ -145,6 +212,16 @@ cdescent_free (cdescent *cd)
 		if (cd->beta) mm_real_free (cd->beta);
 		if (cd->mu) mm_real_free (cd->mu);
 		if (cd->nu) mm_real_free (cd->nu);
+		if (cd->partial) free (cd->partial);
+		if (cd->sampler) sampler_free (cd->sampler);
+		if (cd->acc) acceleration_free (cd->acc);
+		if (cd->greedy) greedy_free (cd->greedy);
+		if (cd->block) block_free (cd->block);
+		if (cd->svrg) svrg_free (cd->svrg);
+		if (cd->lower) free (cd->lower);
+		if (cd->upper) free (cd->upper);
+		if (cd->aa) anderson_free (cd->aa);
+		if (cd->work) workspace_free (cd->work);
 		free (cd);
 	}
 	return;
@@ -157,11 +234,149 @@ cdescent_set_cyclic (cdescent *cd)
 	return;
 }
 
+/* (re)create the sampler of random coordinates, default seed is 1 */
+static void
+set_sampler (cdescent *cd, const unsigned int *seed)
+{
+	bool	importance = false;
+	if (cd->sampler) {
+		importance = cd->sampler->importance;
+		sampler_free (cd->sampler);
+	}
+	cd->sampler = sampler_new (cd, (seed) ? *seed : 1);
+	cd->sampler->importance = importance;
+	return;
+}
+
 void
 cdescent_set_stochastic (cdescent *cd, const unsigned int *seed)
 {
 	cd->rule = CDESCENT_SELECTION_RULE_STOCHASTIC;
-	if (seed) srand (*seed);
+	set_sampler (cd, seed);
+	return;
+}
+
+/*** select coordinates of the stochastic rule in proportion to their curvature
+ * X(:,j)' * X(:,j) + lambda2 * D(:,j)' * D(:,j), instead of uniform random permutation.
+ * This must be called after cdescent_set_stochastic ***/
+void
+cdescent_set_importance_sampling (cdescent *cd)
+{
+	if (cd->rule != CDESCENT_SELECTION_RULE_STOCHASTIC) {
+		printf_warning ("cdescent_set_importance_sampling", "rule is not stochastic, importance sampling is ignored.", __FILE__, __LINE__);
+		return;
+	}
+	cd->sampler->importance = true;
+	return;
+}
+
+/*** use accelerated randomized coordinate descent (APPROX).
+ * This is a serial algorithm, cd->parallel and cd->row_parallel are ignored ***/
+void
+cdescent_set_accelerated (cdescent *cd, const unsigned int *seed)
+{
+	cd->rule = CDESCENT_SELECTION_RULE_ACCELERATED;
+	set_sampler (cd, seed);
+	// coordinates of the accelerated rule are uniformly sampled
+	cd->sampler->importance = false;
+	if (!cd->acc) cd->acc = acceleration_new (cd);
+	return;
+}
+
+/*** use greedy coordinate descent (Gauss-Southwell-Lipschitz rule),
+ * ncache columns of X' * X (and D' * D) are cached,
+ * if ncache <= 0, it is decided so as the cache is up to 512MB.
+ * This is a serial algorithm, cd->parallel and cd->row_parallel are ignored ***/
+void
+cdescent_set_greedy (cdescent *cd, const int ncache)
+{
+	cd->rule = CDESCENT_SELECTION_RULE_GREEDY;
+	if (cd->greedy) greedy_free (cd->greedy);
+	cd->greedy = greedy_new (cd, ncache);
+	return;
+}
+
+/*** use block coordinate descent over blocks of size consecutive columns of X,
+ * e.g. size = nx * ny for the cells of a depth layer.
+ * X must be dense general, or stored in the kernel matrix container, in which case
+ * size = the num of columns of a tile reads each tile at once by its row blocks.
+ * Each block is updated by one proximal gradient step, and only a Lipschitz constant of each block
+ * is kept, so the memory is O(m + size + n / size) instead of the Gram matrices of the blocks.
+ * This is a serial algorithm, cd->parallel and cd->row_parallel are ignored ***/
+void
+cdescent_set_block (cdescent *cd, const int size)
+{
+	cd->rule = CDESCENT_SELECTION_RULE_BLOCK;
+	if (cd->block) block_free (cd->block);
+	cd->block = block_new (cd, size);
+	return;
+}
+
+/*** use proximal stochastic variance reduced gradient method (Prox-SVRG)
+ * over mini-batches of batch consecutive rows of X, instead of coordinate descent.
+ * Each step touches only the rows of a mini-batch, which is suitable for very large m.
+ * X must be dense general.
+ * This is a serial algorithm, cd->parallel and cd->row_parallel are ignored ***/
+void
+cdescent_set_svrg (cdescent *cd, const int batch, const unsigned int *seed)
+{
+	cd->rule = CDESCENT_SELECTION_RULE_SVRG;
+	set_sampler (cd, seed);
+	if (cd->svrg) svrg_free (cd->svrg);
+	cd->svrg = svrg_new (cd, batch);
+	return;
+}
+
+/*** use Anderson extrapolation of the iterates of every k sweeps.
+ * This can be combined with any coordinate selection rule ***/
+void
+cdescent_set_anderson (cdescent *cd, const int k)
+{
+	if (k < 2) error_and_exit ("cdescent_set_anderson", "k must be >= 2.", __FILE__, __LINE__);
+	if (cd->aa) anderson_free (cd->aa);
+	cd->aa = anderson_new (cd, k);
+	return;
+}
+
+/*** parallelize each coordinate update over the rows of X, mu and y
+ * instead of updating coordinates concurrently.
+ * Unlike cd->parallel, this does not introduce staleness of mu,
+ * so the solution path is same as the serial update.
+ * This is available only when X is dense general ***/
+void
+cdescent_set_row_parallel (cdescent *cd)
+{
+	if (!cd->lreg->x || !mm_real_is_dense (cd->lreg->x) || mm_real_is_symmetric (cd->lreg->x)) {
+		printf_warning ("cdescent_set_row_parallel", "X must be dense general, row_parallel is ignored.", __FILE__, __LINE__);
+		return;
+	}
+	cd->row_parallel = true;
+	return;
+}
+
+/* re-allocate vector x with first touch by the threads which own its rows */
+static mm_dense *
+realloc_first_touch (mm_dense *x)
+{
+	mm_dense	*y = mm_real_new (MM_REAL_DENSE, MM_REAL_GENERAL, x->m, 1, x->m);
+	mm_real_first_touch (y, true, 0.);
+	mm_real_memcpy (y, x);
+	mm_real_free (x);
+	return y;
+}
+
+/*** place beta and mu on the NUMA nodes of the threads which update them.
+ * beta(j) is owned by the thread which updates the column X(:,j) in the parallel update,
+ * and mu(i) by the thread which owns the row slice in the row-partitioned update.
+ * This is effective when X itself was allocated by mm_real_first_touch
+ * and the threads are pinned to the cores (e.g. OMP_PLACES=cores) ***/
+void
+cdescent_use_first_touch (cdescent *cd)
+{
+	if (!cd->parallel && !cd->row_parallel) return;
+	cd->first_touch = true;
+	cd->beta = realloc_first_touch (cd->beta);
+	cd->mu = realloc_first_touch (cd->mu);
 	return;
 }
 
@@ -201,13 +416,63 @@ cdescent_not_use_intercept (cdescent *cd)
 	return;
 }
 
+/* free bounds of box constraint */
+static void
+free_box_constraint (cdescent *cd)
+{
+	if (cd->lower) free (cd->lower);
+	if (cd->upper) free (cd->upper);
+	cd->lower = NULL;
+	cd->upper = NULL;
+	return;
+}
+
 void
 cdescent_set_constraint (cdescent *cd, constraint_func func)
 {
+	free_box_constraint (cd);
 	cd->cfunc = func;
 	return;
 }
 
+/* constraint function of box constraint cd->lower <= beta <= cd->upper */
+static bool
+box_constraint_func (cdescent *cd, const int j, const double etaj, double *val)
+{
+	*val = cd->lower[j];
+	if (cd->beta->data[j] + etaj < *val) return false;
+	*val = cd->upper[j];
+	if (cd->beta->data[j] + etaj > *val) return false;
+	return true;
+}
+
+/*** constrain the solution by lower <= beta(j) <= upper in the original scale of X.
+ * The bounds are converted to the scale of cd->beta. The constraint is inlined
+ * in the specialized sweep of serial cyclic rule (see sweep.c), and is applied
+ * through cd->cfunc in the other rules ***/
+void
+cdescent_set_box_constraint (cdescent *cd, const double lower, const double upper)
+{
+	int		j;
+	int		n = *cd->n;
+
+	if (lower > upper) error_and_exit ("cdescent_set_box_constraint", "lower must be <= upper.", __FILE__, __LINE__);
+
+	free_box_constraint (cd);
+	cd->lower = (double *) malloc (n * sizeof (double));
+	cd->upper = (double *) malloc (n * sizeof (double));
+	if (cd->lower == NULL || cd->upper == NULL)
+		error_and_exit ("cdescent_set_box_constraint", "cannot allocate memory.", __FILE__, __LINE__);
+	for (j = 0; j < n; j++) {
+		double	scale = 1.;
+		if (cd->lreg->xnormalized && cd->lreg->xtx) scale = sqrt (cd->lreg->xtx[j]);
+		cd->lower[j] = lower * scale;
+		cd->upper[j] = upper * scale;
+	}
+	cd->cfunc = box_constraint_func;
+	return;
+}
+
 static bool
 is_regtype_l1 (const cdescent *cd)
 {
@@ -326,13 +591,23 @@ beta_in_original_scale (mm_dense *beta, const double *xtx)
 	return;
 }
 
-mm_dense *
-cdescent_get_beta_in_original_scale (const cdescent *cd)
+/* copy beta in original scale into dest without allocation, dest must be size n */
+void
+cdescent_copy_beta_in_original_scale (const cdescent *cd, mm_dense *dest)
 {
-	mm_dense	*beta = mm_real_copy (cd->beta);
+	mm_real_memcpy (dest, cd->beta);
 	if (cd->lreg->xnormalized && cd->lreg->xtx) {
-		beta_in_original_scale (beta, cd->lreg->xtx);
+		beta_in_original_scale (dest, cd->lreg->xtx);
 	}
+	return;
+}
+
+mm_dense *
+cdescent_get_beta_in_original_scale (const cdescent *cd)
+{
+	int			n = *cd->n;
+	mm_dense	*beta = mm_real_new (MM_REAL_DENSE, MM_REAL_GENERAL, n, 1, n);
+	cdescent_copy_beta_in_original_scale (cd, beta);
 	return beta;
 }
 
@@ -343,10 +618,21 @@ cdescent_init_beta (cdescent *cd, const mm_dense *beta)
 		int		n = *cd->n;
 		mm_real_free (cd->beta);
 		cd->beta = mm_real_new (MM_REAL_DENSE, MM_REAL_GENERAL, n, 1, n);
+		if (cd->first_touch) mm_real_first_touch (cd->beta, true, 0.);
 	}
 	mm_real_memcpy (cd->beta, beta);
 	cd->nrm1 = mm_real_xj_asum (cd->beta, 0);
-	mm_real_x_dot_yk (false, 1., cd->lreg->x, cd->beta, 0, 0., cd->mu);
-	if (!cd->is_regtype_lasso) mm_real_x_dot_yk (false, 1., cd->lreg->d, cd->beta, 0, 0., cd->nu);
+	provider_dot_y (false, 1., cd->lreg->prov, cd->beta, 0., cd->mu);
+	if (!cd->is_regtype_lasso) penalty_dot_y (false, 1., cd->lreg->pen, cd->beta, 0., cd->nu);
+	if (cd->acc) cd->acc->restart = true;
 	return;
 }
+
+/*** return the number of mm_real objects and work spaces allocated so far by the solvers.
+ * This does not change in the cycles once the work spaces are allocated,
+ * which is used to confirm that the solvers do not allocate in the steady state ***/
+long
+cdescent_num_allocated (void)
+{
+	return mm_real_num_allocated () + work_num_allocated ();
+}
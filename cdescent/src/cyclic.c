@@ -17,33 +17,75 @@
 extern void		update_intercept (cdescent *cd);
 extern void		cdescent_update (cdescent *cd, int j, double *amax_eta);
 extern void		cdescent_update_atomic (cdescent *cd, int j, double *amax_eta);
+extern double	cdescent_update_beta_nu (cdescent *cd, int j, const double xjmu, double *amax_eta);
+/* rowwise.c */
+extern void		cdescent_update_rowwise (cdescent *cd, const int *index, double *amax_eta);
 
-/*** progress cyclic coordinate descent update for one full cycle ***/
+/* serial sweep of cyclic coordinate descent.
+ * The update mu += eta(j) * X(:,j) and X(:,j+1)' * mu for the next coordinate
+ * are fused in one pass over mu */
+static void
+update_cyclic_fused (cdescent *cd)
+{
+	int		j;
+	int		n = *cd->n;
+	double	xjmu = mm_real_xj_trans_dot_yk (cd->lreg->x, 0, cd->mu, 0);
+
+	for (j = 0; j < n; j++) {
+		// update beta(j) and nu, mu is not updated yet
+		double	etaj = cdescent_update_beta_nu (cd, j, xjmu, &cd->amax_eta);
+		if (j + 1 < n) {
+			if (etaj != 0.) xjmu = mm_real_axjpy_xk_trans_dot_y (etaj, cd->lreg->x, j, j + 1, cd->mu);
+			else xjmu = mm_real_xj_trans_dot_yk (cd->lreg->x, j + 1, cd->mu, 0);
+		} else if (etaj != 0.) mm_real_axjpy (etaj, cd->lreg->x, j, cd->mu);
+	}
+	return;
+}
+
+/*** progress cyclic coordinate descent update for one full cycle.
+ * This function is executed by all threads of the worker team
+ * (see cdescent_do_update_one_cycle), and the serial parts are done by a single thread ***/
 bool
 cdescent_do_update_once_cycle_cyclic (cdescent *cd)
 {
 	int		j;
 	int		n = *cd->n;
-	double	amax_eta;	// max of |eta(j)| = |beta_new(j) - beta_prev(j)|
 
-	/* b = (sum(y) - sum(X) * beta) / m */
-	if (cd->use_intercept) update_intercept (cd);
+#pragma omp single
+	{
+		/* b = (sum(y) - sum(X) * beta) / m */
+		if (cd->use_intercept) update_intercept (cd);
 
-	amax_eta = 0.;
+		// max of |eta(j)| = |beta_new(j) - beta_prev(j)|
+		cd->amax_eta = 0.;
+	}
 
 	/*** single "one-at-a-time" update of cyclic coordinate descent
 	 * the following code was referring to shotgun by A.Kyrola,
 	 * https://github.com/akyrola/shotgun ****/
-	if (cd->parallel) {
-#pragma omp parallel for
-		for (j = 0; j < n; j++) cdescent_update_atomic (cd, j, &amax_eta);
+	if (cd->row_parallel) {
+		// exact update, each coordinate update is parallelized over the rows
+		cdescent_update_rowwise (cd, NULL, &cd->amax_eta);
+	} else if (cd->parallel) {
+		// static schedule : each thread updates the same block of columns of X in every cycle
+#pragma omp for schedule(static)
+		for (j = 0; j < n; j++) cdescent_update_atomic (cd, j, &cd->amax_eta);
 	} else {
-		for (j = 0; j < n; j++) cdescent_update (cd, j, &amax_eta);
+#pragma omp single
+		{
+			if (cd->sweep) cd->sweep (cd);
+			else if (cd->lreg->x) update_cyclic_fused (cd);
+			// X is not in memory, each column is served by the provider
+			else for (j = 0; j < n; j++) cdescent_update (cd, j, &cd->amax_eta);
+		}
 	}
 
-	cd->nrm1 = mm_real_xj_asum (cd->beta, 0);
+#pragma omp single
+	{
+		if (!cd->was_modified) cd->was_modified = true;
 
-	if (!cd->was_modified) cd->was_modified = true;
+		cd->cycle_converged = (cd->amax_eta < cd->tolerance);
+	}
 
-	return (amax_eta < cd->tolerance);
+	return cd->cycle_converged;
 }
@@ -0,0 +1,299 @@
+/*
+ * greedy.c
+ *
+ *  Created on: 2026/10/18
+ *      Author: utsugi
+ */
+
+#include <stdlib.h>
+#include <math.h>
+#include <cdescent.h>
+#include <mmreal.h>
+
+#include "private/private.h"
+
+/* update.c */
+extern void		update_intercept (cdescent *cd);
+/* stepsize.c */
+extern double	cdescent_scale2 (const cdescent *cd, const int j);
+extern double	cdescent_beta_stepsize_at (const cdescent *cd, const int j, const double xjmu, const double djnu);
+
+/* default upper limit of memory used by the cache of Gram columns: 512MB */
+#define GREEDY_CACHE_BYTES	(512. * 1024. * 1024.)
+
+/* allocate greedy object */
+static greedy *
+greedy_alloc (void)
+{
+	greedy	*g = (greedy *) malloc (sizeof (greedy));
+	if (g == NULL) return NULL;
+
+	g->xmu = NULL;
+	g->dnu = NULL;
+
+	g->ncache = 0;
+	g->slot = NULL;
+	g->owner = NULL;
+	g->referred = NULL;
+	g->hand = 0;
+	g->xtx = NULL;
+	g->dtd = NULL;
+
+	g->xj = NULL;
+	g->dj = NULL;
+
+	return g;
+}
+
+/*** create new greedy object, which caches ncache columns of the Gram matrices.
+ * if ncache <= 0, ncache is decided so as the cache uses up to GREEDY_CACHE_BYTES ***/
+greedy *
+greedy_new (const cdescent *cd, const int ncache)
+{
+	int		k;
+	int		n = *cd->n;
+	greedy	*g;
+
+	if (!cd->lreg->x) error_and_exit ("greedy_new", "X must be in memory.", __FILE__, __LINE__);
+
+	g = greedy_alloc ();
+	if (g == NULL) error_and_exit ("greedy_new", "failed to allocate object.", __FILE__, __LINE__);
+
+	g->ncache = ncache;
+	if (g->ncache <= 0) {
+		double	bytes = (double) n * sizeof (double) * ((cd->is_regtype_lasso) ? 1. : 2.);
+		g->ncache = (int) (GREEDY_CACHE_BYTES / bytes);
+	}
+	if (g->ncache < 1) g->ncache = 1;
+	if (g->ncache > n) g->ncache = n;
+
+	g->xmu = vector_new (n);
+	g->xj = vector_new (*cd->m);
+	if (!cd->is_regtype_lasso) {
+		g->dnu = vector_new (n);
+		g->dj = vector_new (cd->lreg->pen->m);
+	}
+
+	g->slot = (int *) malloc (n * sizeof (int));
+	g->owner = (int *) malloc (g->ncache * sizeof (int));
+	g->referred = (bool *) malloc (g->ncache * sizeof (bool));
+	// columns are allocated when they are used first
+	g->xtx = (mm_dense **) malloc (g->ncache * sizeof (mm_dense *));
+	g->dtd = (mm_dense **) malloc (g->ncache * sizeof (mm_dense *));
+	if (g->slot == NULL || g->owner == NULL || g->referred == NULL || g->xtx == NULL || g->dtd == NULL)
+		error_and_exit ("greedy_new", "cannot allocate memory.", __FILE__, __LINE__);
+
+	for (k = 0; k < n; k++) g->slot[k] = -1;
+	for (k = 0; k < g->ncache; k++) {
+		g->owner[k] = -1;
+		g->referred[k] = false;
+		g->xtx[k] = NULL;
+		g->dtd[k] = NULL;
+	}
+
+	return g;
+}
+
+/*** free greedy object ***/
+void
+greedy_free (greedy *g)
+{
+	if (g) {
+		int		k;
+		if (g->xmu) mm_real_free (g->xmu);
+		if (g->dnu) mm_real_free (g->dnu);
+		if (g->slot) free (g->slot);
+		if (g->owner) free (g->owner);
+		if (g->referred) free (g->referred);
+		if (g->xtx) {
+			for (k = 0; k < g->ncache; k++) if (g->xtx[k]) mm_real_free (g->xtx[k]);
+			free (g->xtx);
+		}
+		if (g->dtd) {
+			for (k = 0; k < g->ncache; k++) if (g->dtd[k]) mm_real_free (g->dtd[k]);
+			free (g->dtd);
+		}
+		if (g->xj) mm_real_free (g->xj);
+		if (g->dj) mm_real_free (g->dj);
+		free (g);
+	}
+	return;
+}
+
+/* gram = A' * A(:,j), aj is work space of size A->m */
+static void
+gram_column (const mm_real *a, const int j, mm_dense *aj, mm_dense *gram)
+{
+	mm_real_set_all (aj, 0.);
+	mm_real_axjpy (1., a, j, aj);
+	mm_real_x_dot_yk (true, 1., a, aj, 0, 0., gram);
+	return;
+}
+
+/* return the cache slot of j-th columns of X' * X and D' * D.
+ * If they are not cached, they are calculated and stored in the slot
+ * selected by clock (second chance) replacement */
+static int
+cached_gram_column (cdescent *cd, const int j)
+{
+	greedy	*g = cd->greedy;
+	int		k = g->slot[j];
+
+	if (k >= 0) {
+		g->referred[k] = true;
+		return k;
+	}
+
+	while (g->referred[g->hand]) {
+		g->referred[g->hand] = false;
+		g->hand = (g->hand + 1) % g->ncache;
+	}
+	k = g->hand;
+	g->hand = (k + 1) % g->ncache;
+
+	if (g->owner[k] >= 0) g->slot[g->owner[k]] = -1;
+	g->owner[k] = j;
+	g->slot[j] = k;
+	g->referred[k] = true;
+
+	if (g->xtx[k] == NULL) g->xtx[k] = vector_new (*cd->n);
+	gram_column (cd->lreg->x, j, g->xj, g->xtx[k]);
+	if (!cd->is_regtype_lasso) {
+		if (g->dtd[k] == NULL) g->dtd[k] = vector_new (*cd->n);
+		// D' * D(:,j)
+		mm_real_set_all (g->dj, 0.);
+		penalty_adjpy (1., cd->lreg->pen, j, g->dj);
+		penalty_dot_y (true, 1., cd->lreg->pen, g->dj, 0., g->dtd[k]);
+	}
+	return k;
+}
+
+/* return the expected decrease of the objective function by updating j-th coordinate
+ * L(j) * eta(j)^2 / 2, where L(j) = X(:,j)' * X(:,j) + lambda2 * D(:,j)' * D(:,j)
+ * and eta(j) is the step-size including the constraint, which is set to *etaj.
+ * The factor 1 / 2 is omitted */
+static double
+coordinate_score (cdescent *cd, const int j, const double xjmu, const double djnu, double *etaj)
+{
+	double	val;
+	double	eta = cdescent_beta_stepsize_at (cd, j, xjmu, djnu);
+	if (cd->cfunc && !cd->cfunc (cd, j, eta, &val)) eta = val - cd->beta->data[j];
+	*etaj = eta;
+	return cdescent_scale2 (cd, j) * eta * eta;
+}
+
+/* return the coordinate j which gives the largest expected decrease of the objective function.
+ * *etaj is set to eta(j) and *amax is set to max_j |eta(j)| */
+static int
+select_coordinate (cdescent *cd, double *etaj, double *amax)
+{
+	int		j;
+	int		jmax = 0;
+	int		n = *cd->n;
+	double	smax = -1.;
+	double	*xmu = cd->greedy->xmu->data;
+	double	*dnu = (cd->is_regtype_lasso) ? NULL : cd->greedy->dnu->data;
+
+	*amax = 0.;
+	*etaj = 0.;
+	for (j = 0; j < n; j++) {
+		double	eta;
+		double	score = coordinate_score (cd, j, xmu[j], (dnu) ? dnu[j] : 0., &eta);
+		if (*amax < fabs (eta)) *amax = fabs (eta);
+		if (smax < score) {
+			smax = score;
+			jmax = j;
+			*etaj = eta;
+		}
+	}
+	return jmax;
+}
+
+/* beta(j) += eta(j), update mu, nu, X' * mu and D' * nu, and return the next coordinate.
+ * The scores of all coordinates are changed by the update of X' * mu unless X' * X is sparse,
+ * so the next coordinate is selected in the same pass over X' * mu and D' * nu.
+ * *etak is set to the step-size of the next coordinate and *amax is set to max_k |eta(k)| */
+static int
+update_coordinate (cdescent *cd, const int j, const double etaj, double *etak, double *amax)
+{
+	int		k;
+	int		kmax = 0;
+	int		n = *cd->n;
+	double	smax = -1.;
+	greedy	*g = cd->greedy;
+	int		l = cached_gram_column (cd, j);
+	double	*xmu = g->xmu->data;
+	double	*xtxj = g->xtx[l]->data;
+	double	*dnu = (cd->is_regtype_lasso) ? NULL : g->dnu->data;
+	double	*dtdj = (cd->is_regtype_lasso) ? NULL : g->dtd[l]->data;
+
+	cd->beta->data[j] += etaj;
+	// mu += eta(j) * X(:,j), nu += eta(j) * D(:,j)
+	mm_real_axjpy (etaj, cd->lreg->x, j, cd->mu);
+	if (!cd->is_regtype_lasso) penalty_adjpy (etaj, cd->lreg->pen, j, cd->nu);
+
+	*amax = 0.;
+	*etak = 0.;
+	for (k = 0; k < n; k++) {
+		double	eta;
+		double	score;
+		// X' * mu += eta(j) * X' * X(:,j), D' * nu += eta(j) * D' * D(:,j)
+		xmu[k] += etaj * xtxj[k];
+		if (dnu) dnu[k] += etaj * dtdj[k];
+		score = coordinate_score (cd, k, xmu[k], (dnu) ? dnu[k] : 0., &eta);
+		if (*amax < fabs (eta)) *amax = fabs (eta);
+		if (smax < score) {
+			smax = score;
+			kmax = k;
+			*etak = eta;
+		}
+	}
+	return kmax;
+}
+
+/*** progress greedy coordinate descent for one cycle, i.e. n updates.
+ * In each update, all the step-sizes are evaluated by the maintained X' * mu and D' * nu,
+ * and the coordinate with the largest expected decrease is updated.
+ * An update costs O(n), since X' * mu += eta(j) * X' * X(:,j) touches all of it for dense X
+ * and all the scores are changed. A priority queue would be rebuilt at O(n) in each update,
+ * so the maximum is found by a linear scan fused to the update of X' * mu.
+ * A column X' * X(:,j) which is not cached costs O(m * n), as much as the recalculation of
+ * X' * mu at the start of cycle, so the cache should hold the columns of the active set.
+ * The cycle is converged if max_j |eta(j)| < tolerance,
+ * i.e. no coordinate can move more than the tolerance ***/
+bool
+cdescent_do_update_once_cycle_greedy (cdescent *cd)
+{
+#pragma omp single
+	{
+		int		j;
+		int		k;
+		int		n = *cd->n;
+		double	etaj;
+		double	amax;
+		greedy	*g = cd->greedy;
+
+		/* b = (sum(y) - sum(X) * beta) / m */
+		if (cd->use_intercept) update_intercept (cd);
+
+		// X' * mu and D' * nu are recalculated, so rounding errors are not accumulated over cycles
+		mm_real_x_dot_yk (true, 1., cd->lreg->x, cd->mu, 0, 0., g->xmu);
+		if (!cd->is_regtype_lasso) penalty_dot_y (true, 1., cd->lreg->pen, cd->nu, 0., g->dnu);
+
+		cd->amax_eta = 0.;
+		cd->cycle_converged = false;
+		j = select_coordinate (cd, &etaj, &amax);
+		for (k = 0; k < n; k++) {
+			if (amax < cd->tolerance) {
+				cd->cycle_converged = true;
+				break;
+			}
+			if (cd->amax_eta < fabs (etaj)) cd->amax_eta = fabs (etaj);
+			j = update_coordinate (cd, j, etaj, &etaj, &amax);
+		}
+
+		if (!cd->was_modified) cd->was_modified = true;
+	}
+
+	return cd->cycle_converged;
+}
@@ -11,6 +11,9 @@
 
 #include "private/private.h"
 
+/* cdescent.c */
+extern void	cdescent_copy_beta_in_original_scale (const cdescent *cd, mm_dense *dest);
+
 /* output solution into FILE *stream
  * output format is
  * |beta| b0(intercept) beta[0] beta[1] ... */
@@ -40,8 +43,7 @@ void
 fprintf_solutionpath (FILE *stream, cdescent *cd)
 {
 	double		b0 = cdescent_get_intercept_in_original_scale (cd);
-	mm_dense	*beta = cdescent_get_beta_in_original_scale (cd);
-	fprintf_solution (stream, b0, beta);
-	mm_real_free (beta);
+	cdescent_copy_beta_in_original_scale (cd, cd->work->beta);
+	fprintf_solution (stream, b0, cd->work->beta);
 	return;
 }
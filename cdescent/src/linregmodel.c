@@ -8,6 +8,8 @@
 #include <stdlib.h>
 #include <math.h>
 #include <mmreal.h>
+#include <penalty.h>
+#include <provider.h>
 #include <linregmodel.h>
 
 #include "private/private.h"
@@ -37,18 +39,43 @@ calc_sum (const mm_real *x, double **sum)
 	return centered;
 }
 
-/* calculate sum x(:,j)^2 */
+/* calculate sum X(:,j) of X served by provider */
 static bool
-calc_ssq (const mm_real *x, double **ssq)
+calc_xsum (const provider *p, double **sum)
+{
+	int		j;
+	bool	centered;
+	double	*_sum = (double *) malloc (p->n * sizeof (double));
+#pragma omp parallel for
+	for (j = 0; j < p->n; j++) _sum[j] = provider_xj_sum (p, j);
+	// check whether mean is all 0 (x is already centered)
+	centered = true;
+	for (j = 0; j < p->n; j++) {
+		if (fabs (_sum[j] / (double) p->m) > DBL_EPSILON) {
+			centered = false;
+			break;
+		}
+	}
+	if (centered) {	// mean is all 0
+		*sum = NULL;
+		free (_sum);
+	} else *sum = _sum;
+
+	return centered;
+}
+
+/* calculate sum X(:,j)^2 of X served by provider */
+static bool
+calc_ssq (const provider *p, double **ssq)
 {
 	int		j;
 	bool	normalized;
-	double	*_ssq = (double *) malloc (x->n * sizeof (double));
+	double	*_ssq = (double *) malloc (p->n * sizeof (double));
 #pragma omp parallel for
-	for (j = 0; j < x->n; j++) _ssq[j] = mm_real_xj_ssq (x, j);
+	for (j = 0; j < p->n; j++) _ssq[j] = provider_xj_ssq (p, j);
 	// check whether norm is all 1 (x is already normalized)
 	normalized = true;
-	for (j = 0; j < x->n; j++) {
+	for (j = 0; j < p->n; j++) {
 		if (fabs (_ssq[j] - 1.) > DBL_EPSILON) {
 			normalized = false;
 			break;
@@ -77,15 +104,15 @@ do_centering (mm_dense *x, const double *sum)
 }
 
 /* normalizing each column of matrix:
- * x(:,j) -> x(:,j) / norm(x(:,j)) */
+ * X(:,j) -> X(:,j) / norm(X(:,j)) */
 static void
-do_normalizing (mm_real *x, const double *ssq)
+do_normalizing (provider *p, const double *ssq)
 {
 	int		j;
 #pragma omp parallel for
-	for (j = 0; j < x->n; j++) {
+	for (j = 0; j < p->n; j++) {
 		double	nrm2j = sqrt (ssq[j]);
-		if (fabs (nrm2j - 1.) > DBL_EPSILON) mm_real_xj_scale (x, j, 1. / nrm2j);
+		if (fabs (nrm2j - 1.) > DBL_EPSILON) provider_scale_column (p, j, 1. / nrm2j);
 	}
 	return;
 }
@@ -99,7 +126,8 @@ linregmodel_alloc (void)
 
 	lreg->y = NULL;
 	lreg->x = NULL;
-	lreg->d = NULL;
+	lreg->prov = NULL;
+	lreg->pen = NULL;
 
 	lreg->c = NULL;
 	lreg->camax = 0.;
@@ -119,31 +147,33 @@ linregmodel_alloc (void)
 /*** create new linregmodel object
  * INPUT:
  * mm_dense			*y: dense vector
- * mm_real			*x: sparse or dense general / symmetric matrix
- * const mm_real	*d: general linear penalty operator
+ * provider			*prov: column provider of X (see provider.c), which is owned by the object
+ * const penalty	*pen: linear penalty operator, which is copied (stored D is shared)
  * PreProc			proc: specify pre-processings for y and x
  * 						DO_CENTERING_Y: centering of y
  * 						DO_CENTERING_X: centering of each column of x
  * 						DO_NORMALIZING_X: normalizing of each column of x
- * 						DO_STANDARDIZING_X: centering and normalizing of each column of x ***/
+ * 						DO_STANDARDIZING_X: centering and normalizing of each column of x
+ * If the provider knows the sum and the squared norm of the columns of original X
+ * (e.g. provider_new_xmatfile), X is regarded as normalized and the pre-processings of x are not done ***/
 linregmodel *
-linregmodel_new (mm_real *y, mm_real *x, mm_real *d, PreProc proc)
+linregmodel_new_with_provider (mm_real *y, provider *prov, const penalty *pen, PreProc proc)
 {
 	int			j;
 	linregmodel	*lreg;
 
 	/* check whether x and y are not empty */
 	if (!y) error_and_exit ("linregmodel_new", "y is empty.", __FILE__, __LINE__);
-	if (!x) error_and_exit ("linregmodel_new", "x is empty.", __FILE__, __LINE__);
+	if (!prov) error_and_exit ("linregmodel_new", "x is empty.", __FILE__, __LINE__);
 
 	/* check whether y is vector */
 	if (y->n != 1) error_and_exit ("linregmodel_new", "y must be vector.", __FILE__, __LINE__);
 
 	/* check dimensions of x and y */
-	if (y->m != x->m) error_and_exit ("linregmodel_new", "dimensions of x and y do not match.", __FILE__, __LINE__);
+	if (y->m != prov->m) error_and_exit ("linregmodel_new", "dimensions of x and y do not match.", __FILE__, __LINE__);
 
 	/* check dimensions of x and d */
-	if (d && x->n != d->n) error_and_exit ("linregmodel_new", "dimensions of x and d do not match.", __FILE__, __LINE__);
+	if (pen && prov->n != pen->n) error_and_exit ("linregmodel_new", "dimensions of x and d do not match.", __FILE__, __LINE__);
 
 	lreg = linregmodel_alloc ();
 	if (lreg == NULL) error_and_exit ("linregmodel_new", "failed to allocate memory for linregmodel object.", __FILE__, __LINE__);
@@ -158,42 +188,62 @@ linregmodel_new (mm_real *y, mm_real *x, mm_real *d, PreProc proc)
 		lreg->ycentered = true;
 	}
 
-	lreg->x = x;
-	lreg->xcentered = calc_sum (lreg->x, &lreg->sx);
-	/* if DO_CENTERING_X is set and x is not already centered */
-	if ((proc & DO_CENTERING_X) && !lreg->xcentered) {
-		/* if lreg->x is sparse, convert to dense matrix */
-		if (mm_real_is_sparse (lreg->x)) mm_real_sparse_to_dense (lreg->x);
-		/* if lreg->x is symmetric, convert to general matrix */
-		if (mm_real_is_symmetric (lreg->x)) mm_real_symmetric_to_general (lreg->x);
-		do_centering (lreg->x, lreg->sx);
-		lreg->xcentered = true;
-	};
-
-	lreg->xnormalized = calc_ssq (lreg->x, &lreg->xtx);
-	/* if DO_NORMALIZING_X is set and x is not already normalized */
-	if ((proc & DO_NORMALIZING_X) && !lreg->xnormalized) {
-		/* if lreg->x is symmetric, convert to general matrix */
-		if (mm_real_is_symmetric (lreg->x)) mm_real_symmetric_to_general (lreg->x);
-		do_normalizing (lreg->x, lreg->xtx);
+	lreg->prov = prov;
+	lreg->x = prov->x;
+
+	if (prov->xtx) {
+		/* columns are already normalized, and sum and norm of original X are known */
+		lreg->sx = (double *) malloc (prov->n * sizeof (double));
+		lreg->xtx = (double *) malloc (prov->n * sizeof (double));
+		dcopy_ (&prov->n, prov->sx, &ione, lreg->sx, &ione);
+		dcopy_ (&prov->n, prov->xtx, &ione, lreg->xtx, &ione);
+		lreg->xcentered = false;
 		lreg->xnormalized = true;
+	} else {
+		lreg->xcentered = calc_xsum (prov, &lreg->sx);
+		/* if DO_CENTERING_X is set and x is not already centered */
+		if ((proc & DO_CENTERING_X) && !lreg->xcentered) {
+			if (!lreg->x) error_and_exit ("linregmodel_new", "centering of x not in memory is not supported.", __FILE__, __LINE__);
+			/* if lreg->x is sparse, convert to dense matrix */
+			if (mm_real_is_sparse (lreg->x)) mm_real_sparse_to_dense (lreg->x);
+			/* if lreg->x is symmetric, convert to general matrix */
+			if (mm_real_is_symmetric (lreg->x)) mm_real_symmetric_to_general (lreg->x);
+			do_centering (lreg->x, lreg->sx);
+			lreg->xcentered = true;
+		};
+
+		lreg->xnormalized = calc_ssq (prov, &lreg->xtx);
+		/* if DO_NORMALIZING_X is set and x is not already normalized */
+		if ((proc & DO_NORMALIZING_X) && !lreg->xnormalized) {
+			/* if lreg->x is symmetric, convert to general matrix */
+			if (lreg->x && mm_real_is_symmetric (lreg->x)) mm_real_symmetric_to_general (lreg->x);
+			do_normalizing (prov, lreg->xtx);
+			lreg->xnormalized = true;
+		}
 	}
 
 	/* copy d */
-	if (d) {
-		lreg->d = d;
-		lreg->dtd = (double *) malloc (lreg->d->n * sizeof (double));
+	if (pen) {
+		lreg->pen = penalty_copy (pen);
+		lreg->dtd = (double *) malloc (lreg->pen->n * sizeof (double));
 #pragma omp parallel for
-		for (j = 0; j < lreg->d->n; j++) {
-			lreg->dtd[j] = mm_real_xj_ssq (lreg->d, j);
+		for (j = 0; j < lreg->pen->n; j++) {
+			lreg->dtd[j] = penalty_dj_ssq (lreg->pen, j);
 		}
 	}
 
+	/* row index of sparse x and d, so that X * beta and D * beta
+	 * (e.g. cdescent_init_beta) are calculated by parallel gathers over the rows */
+	if (lreg->x && mm_real_is_sparse (lreg->x) && !mm_real_is_symmetric (lreg->x)) mm_real_build_transposed_index (lreg->x);
+	if (lreg->pen && !penalty_is_implicit (lreg->pen)
+		&& mm_real_is_sparse (lreg->pen->d) && !mm_real_is_symmetric (lreg->pen->d))
+		mm_real_build_transposed_index (lreg->pen->d);
+
 	// c = X' * y
-	lreg->c = mm_real_new (MM_REAL_DENSE, MM_REAL_GENERAL, lreg->x->n, 1, lreg->x->n);
+	lreg->c = mm_real_new (MM_REAL_DENSE, MM_REAL_GENERAL, prov->n, 1, prov->n);
 #pragma omp parallel for
-	for (j = 0; j < lreg->x->n; j++) {
-		lreg->c->data[j] = mm_real_xj_trans_dot_yk (lreg->x, j, lreg->y, 0);
+	for (j = 0; j < prov->n; j++) {
+		lreg->c->data[j] = provider_xj_trans_dot_y (prov, j, lreg->y);
 	}
 
 	// camax = max ( abs (c) )
@@ -202,6 +252,29 @@ linregmodel_new (mm_real *y, mm_real *x, mm_real *d, PreProc proc)
 	return lreg;
 }
 
+/*** create new linregmodel object, where
+ * mm_real	*x: sparse or dense general / symmetric matrix, which is not copied
+ * see linregmodel_new_with_provider ***/
+linregmodel *
+linregmodel_new_with_penalty (mm_real *y, mm_real *x, const penalty *pen, PreProc proc)
+{
+	if (!x) error_and_exit ("linregmodel_new", "x is empty.", __FILE__, __LINE__);
+	return linregmodel_new_with_provider (y, provider_new_matrix (x), pen, proc);
+}
+
+/*** create new linregmodel object, where
+ * mm_real	*d: general linear penalty operator stored in mm_real, or NULL (Lasso)
+ * see linregmodel_new_with_penalty ***/
+linregmodel *
+linregmodel_new (mm_real *y, mm_real *x, mm_real *d, PreProc proc)
+{
+	linregmodel	*lreg;
+	penalty		*pen = (d) ? penalty_new_matrix (d) : NULL;
+	lreg = linregmodel_new_with_penalty (y, x, pen, proc);
+	if (pen) penalty_free (pen);
+	return lreg;
+}
+
 /*** free linregmodel object ***/
 void
 linregmodel_free (linregmodel *lreg)
@@ -211,6 +284,8 @@ linregmodel_free (linregmodel *lreg)
 		if (lreg->sx) free (lreg->sx);
 		if (lreg->xtx) free (lreg->xtx);
 		if (lreg->dtd) free (lreg->dtd);
+		if (lreg->pen) penalty_free (lreg->pen);
+		if (lreg->prov) provider_free (lreg->prov);
 		free (lreg);
 	}
 	return;
@@ -6,14 +6,23 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
 #include <math.h>
 #include <stdbool.h>
+#include <unistd.h>
+#include <sys/stat.h>
 
 #include <mmreal.h>
 
 #include "private/private.h"
 #include "private/atomic.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 /* mm_real supports real symmetric/general sparse/dense matrix */
 static bool
 is_type_supported (const MM_typecode typecode)
@@ -47,6 +56,9 @@ is_symm_valid (const MMRealSymm symm)
 			|| symm == MM_REAL_SYMMETRIC_LOWER);
 }
 
+/* number of mm_real objects allocated so far */
+static long	num_allocated = 0;
+
 /* allocate mm_real */
 static mm_real *
 mm_real_alloc (void)
@@ -54,6 +66,9 @@ mm_real_alloc (void)
 	mm_real	*x = (mm_real *) malloc (sizeof (mm_real));
 	if (x == NULL) return NULL;
 
+#pragma omp atomic
+	num_allocated++;
+
 	x->m = 0;
 	x->n = 0;
 	x->nnz = 0;
@@ -61,6 +76,10 @@ mm_real_alloc (void)
 	x->p = NULL;
 	x->data = NULL;
 
+	x->tp = NULL;
+	x->tj = NULL;
+	x->tl = NULL;
+
 	x->symm = MM_REAL_GENERAL;
 
 	/* set typecode = "M_RG" : Matrix Real General */
@@ -74,6 +93,17 @@ mm_real_alloc (void)
 	return x;
 }
 
+/*** return the number of mm_real objects allocated so far,
+ * which is used to confirm that no object is allocated in the loops of the solvers ***/
+long
+mm_real_num_allocated (void)
+{
+	long	num;
+#pragma omp atomic read
+	num = num_allocated;
+	return num;
+}
+
 /*** create new mm_real object
  * MMRealFormat	format: MM_REAL_DENSE or MM_REAL_SPARSE
  * MMRealSymm		symm  : MM_REAL_GENERAL, MM_REAL_SYMMETRIC_UPPER or MM_REAL_SYMMETRIC_LOWER
@@ -127,6 +157,20 @@ mm_real_new (MMRealFormat format, MMRealSymm symm, const int m, const int n, con
 	return x;
 }
 
+/* free transposed index of symmetric sparse.
+ * This must be called when the nonzero pattern of x is changed */
+static void
+mm_real_clear_transposed_index (mm_real *x)
+{
+	if (x->tp) free (x->tp);
+	if (x->tj) free (x->tj);
+	if (x->tl) free (x->tl);
+	x->tp = NULL;
+	x->tj = NULL;
+	x->tl = NULL;
+	return;
+}
+
 /*** free mm_real ***/
 void
 mm_real_free (mm_real *x)
@@ -135,6 +179,7 @@ mm_real_free (mm_real *x)
 		if (x->i) free (x->i);
 		if (x->p) free (x->p);
 		if (x->data) free (x->data);
+		mm_real_clear_transposed_index (x);
 		free (x);
 	}
 	return;
@@ -144,6 +189,7 @@ mm_real_free (mm_real *x)
 bool
 mm_real_realloc (mm_real *x, const int nnz)
 {
+	mm_real_clear_transposed_index (x);
 	if (x->nnz == nnz) return true;
 	x->data = (double *) realloc (x->data, nnz * sizeof (double));
 	if (x->data == NULL) return false;
@@ -218,6 +264,7 @@ mm_real_sort_sparse (mm_sparse *s)
 	int		*sp = s->p;
 	matrix_element	t[s->m];
 
+	mm_real_clear_transposed_index (s);
 	for (j = 0; j < s->n; j++) {
 		int		k;
 		int		p = sp[j];
@@ -261,6 +308,7 @@ mm_real_memcpy_sparse (mm_sparse *dest, const mm_sparse *src)
 	int			*di = dest->i;
 	int			*dp = dest->p;
 
+	mm_real_clear_transposed_index (dest);
 	for (k = 0; k < nnz; k++) di[k] = si[k];
 	for (k = 0; k <= n; k++) dp[k] = sp[k];
 	dcopy_ (&nnz, src->data, &ione, dest->data, &ione);
@@ -430,6 +478,39 @@ mm_real_set_all (mm_real *x, const double val)
 	return;
 }
 
+/*** set x->data to val in parallel, so as to place the memory pages of x->data
+ * on the NUMA node of the thread which owns them (first-touch policy of the OS).
+ * If rowwise = false, each thread touches a contiguous block of columns
+ * which is same as the block assigned by "omp for schedule(static)" over the columns,
+ * otherwise each thread touches the same row slice of all columns,
+ * which is used by the row-partitioned coordinate descent.
+ * This must be called just after mm_real_new, before any other thread writes x->data.
+ * x must be dense ***/
+void
+mm_real_first_touch (mm_real *x, const bool rowwise, const double val)
+{
+	if (!mm_real_is_dense (x)) error_and_exit ("mm_real_first_touch", "matrix must be dense.", __FILE__, __LINE__);
+
+#pragma omp parallel proc_bind(spread)
+	{
+		int		tid = 0;
+		int		nth = 1;
+		int		j, start, len;
+#ifdef _OPENMP
+		tid = omp_get_thread_num ();
+		nth = omp_get_num_threads ();
+#endif
+		if (rowwise) {
+			static_partition (x->m, nth, tid, &start, &len);
+			for (j = 0; j < x->n; j++) mm_real_array_set_all (len, x->data + (size_t) j * x->m + start, val);
+		} else {
+			static_partition (x->n, nth, tid, &start, &len);
+			mm_real_array_set_all (len * x->m, x->data + (size_t) start * x->m, val);
+		}
+	}
+	return;
+}
+
 /* convert sparse to dense */
 bool
 mm_real_sparse_to_dense (mm_sparse *s)
@@ -448,6 +529,7 @@ mm_real_sparse_to_dense (mm_sparse *s)
 	double	*sd;
 
 	if (!mm_real_is_sparse (s)) return false;
+	mm_real_clear_transposed_index (s);
 
 	m = s->m;
 	n = s->n;
@@ -539,31 +621,133 @@ mm_real_dense_to_sparse (mm_dense *d, const double threshold)
 	return true;
 }
 
-/* binary search: search the value key from array *s of length n.
- * if found, return its index otherwise -1 */
-static int
-bin_search (const int key, const int *s, const int n)
+/* build row index of sparse s, i.e. the positions of the elements of each row ordered by column.
+ * If s is symmetric, only the off-diagonal elements are indexed, which are
+ * the elements of each column stored in the other triangle.
+ * The columns are divided into chunks, and the elements of the chunks are
+ * counted and placed in parallel */
+static void
+mm_real_make_transposed_index (mm_sparse *s)
+{
+	int		c, r;
+	int		m = s->m;
+	int		nchunks = 1;
+	int		chunk;
+	bool	offdiag = mm_real_is_symmetric (s);
+	int		*tp;
+	int		*tj;
+	int		*tl;
+	int		*cnt;
+
+#ifdef _OPENMP
+	nchunks = omp_get_max_threads ();
+#endif
+	if (nchunks > s->n) nchunks = (s->n > 0) ? s->n : 1;
+	chunk = (s->n + nchunks - 1) / nchunks;
+
+	tp = (int *) malloc ((m + 1) * sizeof (int));
+	// cnt[c * m + r]: number of elements of r-th row in c-th chunk, then its first position
+	cnt = (int *) malloc ((size_t) nchunks * m * sizeof (int));
+	if (tp == NULL || cnt == NULL)
+		error_and_exit ("mm_real_make_transposed_index", "cannot allocate memory.", __FILE__, __LINE__);
+
+#pragma omp parallel for
+	for (c = 0; c < nchunks; c++) {
+		int		i, j, k;
+		int		j1 = (c + 1) * chunk;
+		int		*cc = cnt + (size_t) c * m;
+		if (j1 > s->n) j1 = s->n;
+		for (i = 0; i < m; i++) cc[i] = 0;
+		for (j = c * chunk; j < j1; j++) {
+			for (k = s->p[j]; k < s->p[j + 1]; k++) if (!offdiag || s->i[k] != j) cc[s->i[k]]++;
+		}
+	}
+
+	// row pointers, and the first position of each chunk in each row
+	tp[0] = 0;
+	for (r = 0; r < m; r++) {
+		int		pos = tp[r];
+		for (c = 0; c < nchunks; c++) {
+			int		n = cnt[(size_t) c * m + r];
+			cnt[(size_t) c * m + r] = pos;
+			pos += n;
+		}
+		tp[r + 1] = pos;
+	}
+
+	tj = (int *) malloc ((tp[m] + 1) * sizeof (int));
+	tl = (int *) malloc ((tp[m] + 1) * sizeof (int));
+	if (tj == NULL || tl == NULL)
+		error_and_exit ("mm_real_make_transposed_index", "cannot allocate memory.", __FILE__, __LINE__);
+
+#pragma omp parallel for
+	for (c = 0; c < nchunks; c++) {
+		int		j, k;
+		int		j1 = (c + 1) * chunk;
+		int		*next = cnt + (size_t) c * m;
+		if (j1 > s->n) j1 = s->n;
+		for (j = c * chunk; j < j1; j++) {
+			for (k = s->p[j]; k < s->p[j + 1]; k++) {
+				int		i = s->i[k];
+				if (offdiag && i == j) continue;
+				tj[next[i]] = j;
+				tl[next[i]++] = k;
+			}
+		}
+	}
+	free (cnt);
+
+	s->tj = tj;
+	s->tl = tl;
+	// tp is set at last, since it indicates that the index is available,
+	// and tj and tl are flushed before tp is published to other threads
+#pragma omp flush
+#pragma omp atomic write
+	s->tp = tp;
+	return;
+}
+
+/* return tp of transposed index of symmetric sparse s, which is built on first use.
+ * The elements of j-th row are s->tj[l] (column) and s->data[s->tl[l]] for tp[j] <= l < tp[j + 1],
+ * so that a column of s is accessed in time proportional to its nonzeros.
+ * The threads may call this concurrently, so s->tp is read atomically out of the critical section,
+ * and the index is built by only one thread */
+static const int *
+mm_real_transposed_index (const mm_sparse *s)
 {
-	int	start = 0;
-	int	end = n - 1;
-	int	mid;
-	while (start < end) {
-		mid = (start + end) / 2;
-		if (key <= s[mid]) end = mid;
-		else start = mid + 1;
+	int		*tp;
+
+#pragma omp atomic read
+	tp = s->tp;
+	if (tp != NULL) {
+		// tj and tl, which are written before tp, are visible after tp is read
+#pragma omp flush
+		return tp;
+	}
+#pragma omp critical (mm_real_transposed_index)
+	{
+		// read again, since the index may be built by another thread
+#pragma omp atomic read
+		tp = s->tp;
+		if (tp == NULL) {
+			mm_real_make_transposed_index ((mm_sparse *) s);
+			tp = s->tp;
+		}
 	}
-	return (key == s[end]) ? end : -1;
+	return tp;
 }
 
-/* find element that s->i[l] = j in the k-th column of s and return its index l */
-static int
-find_row_element (const int j, const mm_sparse *s, const int k)
+/*** build row index (CSR mirror) of sparse s, which stores the column and the position
+ * in s->data of the elements of each row, so that s * y is calculated by
+ * parallel gathers over the rows. The values are not copied, so that the index
+ * remains valid if the elements are scaled, and it is freed when the nonzero pattern
+ * is changed. For symmetric s, the index is built on first use of a column ***/
+void
+mm_real_build_transposed_index (mm_sparse *s)
 {
-	int		p = s->p[k];
-	int		n = s->p[k + 1] - p;
-	int		*si = s->i + p;
-	int		res = bin_search (j, si, n);
-	return (res < 0) ? -1 : res + p;
+	if (!mm_real_is_sparse (s)) error_and_exit ("mm_real_build_transposed_index", "matrix must be sparse.", __FILE__, __LINE__);
+	if (s->tp == NULL) mm_real_make_transposed_index (s);
+	return;
 }
 
 /* convert sparse symmetric -> sparse general */
@@ -580,9 +764,11 @@ mm_real_symmetric_to_general_sparse (const mm_sparse *x)
 	int			*xi = x->i;
 	int			*xp = x->p;
 	double		*xd = x->data;
+	const int	*tp;
 
 	if (!mm_real_is_symmetric (x)) return mm_real_copy (x);
 	s = mm_real_new (MM_REAL_SPARSE, MM_REAL_GENERAL, x->m, x->n, 2 * x->nnz);
+	tp = mm_real_transposed_index (x);
 
 	si = s->i;
 	sp = s->p;
@@ -597,22 +783,14 @@ mm_real_symmetric_to_general_sparse (const mm_sparse *x)
 				si[i] = xi[k];
 				sd[i++] = xd[k];
 			}
-			for (k = j + 1; k < xn; k++) {
-				int		l = find_row_element (j, x, k);
-				// if found
-				if (l >= 0) {
-					si[i] = k;
-					sd[i++] = xd[l];
-				}
+			for (k = tp[j]; k < tp[j + 1]; k++) {
+				si[i] = x->tj[k];
+				sd[i++] = xd[x->tl[k]];
 			}
 		} else if (mm_real_is_lower (x)) {
-			for (k = 0; k < j; k++) {
-				int		l = find_row_element (j, x, k);
-				// if found
-				if (l >= 0) {
-					si[i] = k;
-					sd[i++] = xd[l];
-				}
+			for (k = tp[j]; k < tp[j + 1]; k++) {
+				si[i] = x->tj[k];
+				sd[i++] = xd[x->tl[k]];
 			}
 			for (k = xp[j]; k < pend; k++) {
 				si[i] = xi[k];
@@ -654,6 +832,7 @@ mm_real_symmetric_to_general (mm_real *x)
 		if (s->nnz != x->nnz) mm_real_realloc (x, s->nnz);
 		mm_real_memcpy_sparse (x, s);
 		mm_real_free (s);
+		mm_real_set_general (x);
 	} else {
 		mm_real_symmetric_to_general_dense (x);
 	}
@@ -869,20 +1048,8 @@ mm_real_sj_asum (const mm_sparse *s, const int j)
 	double	asum = dasum_ (&n, sd + p, &ione);
 	if (mm_real_is_symmetric (s)) {
 		int		k;
-		int		k0;
-		int		k1;
-		if (mm_real_is_upper (s)) {
-			k0 = j + 1;
-			k1 = s->n;
-		} else {
-			k0 = 0;
-			k1 = j;
-		}
-		for (k = k0; k < k1; k++) {
-			int		l = find_row_element (j, s, k);
-			// if found
-			if (l >= 0) asum += fabs (sd[l]);
-		}
+		const int	*tp = mm_real_transposed_index (s);
+		for (k = tp[j]; k < tp[j + 1]; k++) asum += fabs (sd[s->tl[k]]);
 	}
 	return asum;
 }
@@ -929,21 +1096,9 @@ mm_real_sj_sum (const mm_sparse *s, const int j)
 	double	sum = 0.;
 	for (k = 0; k < n; k++) sum += sd[k];
 	if (mm_real_is_symmetric (s)) {
-		int		k0;
-		int		k1;
-		if (mm_real_is_upper (s)) {
-			k0 = j + 1;
-			k1 = s->n;
-		} else {
-			k0 = 0;
-			k1 = j;
-		}
+		const int	*tp = mm_real_transposed_index (s);
 		sd = s->data;
-		for (k = k0; k < k1; k++) {
-			int		l = find_row_element (j, s, k);
-			// if found
-			if (l >= 0) sum += sd[l];
-		}
+		for (k = tp[j]; k < tp[j + 1]; k++) sum += sd[s->tl[k]];
 	}
 	return sum;
 }
@@ -997,20 +1152,8 @@ mm_real_sj_ssq (const mm_sparse *s, const int j)
 	double	ssq = ddot_ (&n, sd + p, &ione, sd + p, &ione);
 	if (mm_real_is_symmetric (s)) {
 		int		k;
-		int		k0;
-		int		k1;
-		if (mm_real_is_upper (s)) {
-			k0 = j + 1;
-			k1 = s->n;
-		} else {
-			k0 = 0;
-			k1 = j;
-		}
-		for (k = k0; k < k1; k++) {
-			int		l = find_row_element (j, s, k);
-			// if found
-			if (l >= 0) ssq += pow (sd[l], 2.);
-		}
+		const int	*tp = mm_real_transposed_index (s);
+		for (k = tp[j]; k < tp[j + 1]; k++) ssq += pow (sd[s->tl[k]], 2.);
 	}
 	return ssq;
 }
@@ -1076,13 +1219,11 @@ mm_real_s_dot_yk (const bool trans, const double alpha, const mm_sparse *s, cons
 
 	if (trans) {
 		if (!mm_real_is_symmetric (s)) {
+			// gather over each column, which is independent of the others
+#pragma omp parallel for
 			for (j = 0; j < s->n; j++) {
-				p = sp[j];
-				n = sp[j + 1] - p;
-				if (n <= 0) continue;
-				si = s->i + p;
-				sd = s->data + p;
-				for (l = 0; l < n; l++) zk[j] += alpha * sd[l] * yk[si[l]];
+				int		q;
+				for (q = sp[j]; q < sp[j + 1]; q++) zk[j] += alpha * s->data[q] * yk[s->i[q]];
 			}
 		} else if (mm_real_is_upper (s)) {
 			int		sil;
@@ -1128,7 +1269,15 @@ mm_real_s_dot_yk (const bool trans, const double alpha, const mm_sparse *s, cons
 			}
 		}
 	} else {
-		if (!mm_real_is_symmetric (s)) {
+		if (!mm_real_is_symmetric (s) && s->tp) {
+			int		i;
+			// gather over each row by the row index (CSR), in the same order as the scatter below
+#pragma omp parallel for
+			for (i = 0; i < s->m; i++) {
+				int		q;
+				for (q = s->tp[i]; q < s->tp[i + 1]; q++) zk[i] += alpha * s->data[s->tl[q]] * yk[s->tj[q]];
+			}
+		} else if (!mm_real_is_symmetric (s)) {
 			for (j = 0; j < s->n; j++) {
 				p = sp[j];
 				n = sp[j + 1] - p;
@@ -1251,21 +1400,9 @@ mm_real_sj_trans_dot_yk (const mm_sparse *s, const int j, const mm_dense *y, con
 	for (l = 0; l < n; l++) val += sd[l] * yk[si[l]];
 
 	if (mm_real_is_symmetric (s)) {
-		int		l0;
-		int		l1;
-		if (mm_real_is_upper (s)) {
-			l0 = j + 1;
-			l1 = s->n;
-		} else {
-			l0 = 0;
-			l1 = j;
-		}
+		const int	*tp = mm_real_transposed_index (s);
 		sd = s->data;
-		for (l = l0; l < l1; l++) {
-			int		t = find_row_element (j, s, l);
-			// if found
-			if (t >= 0) val += sd[t] * yk[l];
-		}
+		for (l = tp[j]; l < tp[j + 1]; l++) val += sd[s->tl[l]] * yk[s->tj[l]];
 	}
 
 	return val;
@@ -1339,21 +1476,9 @@ mm_real_asjpy (const double alpha, const mm_sparse *s, const int j, mm_dense *y)
 	sd = s->data + p;
 	for (k = 0; k < n; k++) yd[si[k]] += alpha * sd[k];
 	if (mm_real_is_symmetric (s)) {
-		int		k0;
-		int		k1;
-		if (mm_real_is_upper (s)) {
-			k0 = j + 1;
-			k1 = s->n;
-		} else {
-			k0 = 0;
-			k1 = j;
-		}
+		const int	*tp = mm_real_transposed_index (s);
 		sd = s->data;
-		for (k = k0; k < k1; k++) {
-			int		l = find_row_element (j, s, k);
-			// if found
-			if (l >= 0) yd[k] += alpha * sd[l];
-		}
+		for (k = tp[j]; k < tp[j + 1]; k++) yd[s->tj[k]] += alpha * sd[s->tl[k]];
 	}
 	return;
 }
@@ -1408,21 +1533,9 @@ mm_real_asjpy_atomic (const double alpha, const mm_sparse *s, const int j, mm_de
 	sd = s->data + p;
 	for (k = 0; k < n; k++) atomic_add (yd + si[k], alpha * sd[k]);
 	if (mm_real_is_symmetric (s)) {
-		int		k0;
-		int		k1;
-		if (mm_real_is_upper (s)) {
-			k0 = j + 1;
-			k1 = s->n;
-		} else {
-			k0 = 0;
-			k1 = j;
-		}
+		const int	*tp = mm_real_transposed_index (s);
 		sd = s->data;
-		for (k = k0; k < k1; k++) {
-			int		l = find_row_element (j, s, k);
-			// if found
-			if (l >= 0) atomic_add (yd + k, alpha * sd[l]);
-		}
+		for (k = tp[j]; k < tp[j + 1]; k++) atomic_add (yd + s->tj[k], alpha * sd[s->tl[k]]);
 	}
 	return;
 }
@@ -1472,6 +1585,34 @@ mm_real_axjpy_atomic (const double alpha, const mm_real *x, const int j, mm_dens
 	return (mm_real_is_sparse (x)) ? mm_real_asjpy_atomic (alpha, x, j, y) : mm_real_adjpy_atomic (alpha, x, j, y);
 }
 
+/* y = alpha * d(:,j) + y and return d(:,k)' * y of updated y,
+ * which are done in one pass over y. d must be general */
+static double
+mm_real_adjpy_dk_trans_dot_y (const double alpha, const mm_dense *d, const int j, const int k, mm_dense *y)
+{
+	return axpy_dot (d->m, alpha, d->data + (size_t) j * d->m, d->data + (size_t) k * d->m, y->data);
+}
+
+/*** y = alpha * x(:,j) + y and return x(:,k)' * y of updated y.
+ * If x is dense general, this is done in one pass over y, so that
+ * y is streamed once for the update of j-th and the dot of k-th columns ***/
+double
+mm_real_axjpy_xk_trans_dot_y (const double alpha, const mm_real *x, const int j, const int k, mm_dense *y)
+{
+	if (j < 0 || x->n <= j || k < 0 || x->n <= k)
+		error_and_exit ("mm_real_axjpy_xk_trans_dot_y", "index out of range.", __FILE__, __LINE__);
+	if (!mm_real_is_dense (y)) error_and_exit ("mm_real_axjpy_xk_trans_dot_y", "y must be dense.", __FILE__, __LINE__);
+	if (mm_real_is_symmetric (y)) error_and_exit ("mm_real_axjpy_xk_trans_dot_y", "y must be general.", __FILE__, __LINE__);
+	if (y->n != 1) error_and_exit ("mm_real_axjpy_xk_trans_dot_y", "y must be vector.", __FILE__, __LINE__);
+	if (x->m != y->m)
+		error_and_exit ("mm_real_axjpy_xk_trans_dot_y", "vector and matrix dimensions do not match.", __FILE__, __LINE__);
+
+	if (mm_real_is_dense (x) && !mm_real_is_symmetric (x)) return mm_real_adjpy_dk_trans_dot_y (alpha, x, j, k, y);
+
+	mm_real_axjpy (alpha, x, j, y);
+	return mm_real_xj_trans_dot_yk (x, k, y, 0);
+}
+
 /* fread sparse */
 static mm_sparse *
 mm_real_fread_sparse (FILE *fp, MM_typecode typecode)
@@ -1589,3 +1730,362 @@ mm_real_fwrite (FILE *stream, const mm_real *x, const char *format)
 {
 	return (mm_real_is_sparse (x)) ? mm_real_fwrite_sparse (stream, x, format) : mm_real_fwrite_dense (stream, x, format);
 }
+
+/*** size in bytes of a column of X of size m stored in the xmat file of format ***/
+size_t
+mm_real_xmatfile_record_size (const MMRealXmatFormat format, const int m)
+{
+	switch (format) {
+		case MM_REAL_XMAT_FLOAT32:
+			return (size_t) m * sizeof (float);
+		case MM_REAL_XMAT_INT16:
+			return sizeof (float) + (size_t) m * sizeof (int16_t);
+		default:
+			break;
+	}
+	return (size_t) m * sizeof (double);
+}
+
+/*** encode xj (size m) into the record rec of the xmat file of format,
+ * where the size of rec is mm_real_xmatfile_record_size (format, m).
+ * MM_REAL_XMAT_INT16 stores scale = max |xj(i)| / 32767 as float at the head,
+ * followed by q(i) = round (xj(i) / scale), so that the relative error is about 1.5e-5 ***/
+void
+mm_real_xmatfile_encode (const MMRealXmatFormat format, const int m, const double *xj, void *rec)
+{
+	int		i;
+	switch (format) {
+		case MM_REAL_XMAT_FLOAT32:
+		{
+			float	*f = (float *) rec;
+			for (i = 0; i < m; i++) f[i] = (float) xj[i];
+			break;
+		}
+		case MM_REAL_XMAT_INT16:
+		{
+			double	amax = 0.;
+			float	scale;
+			int16_t	*q = (int16_t *) ((char *) rec + sizeof (float));
+			for (i = 0; i < m; i++) if (amax < fabs (xj[i])) amax = fabs (xj[i]);
+			scale = (float) (amax / 32767.);
+			memcpy (rec, &scale, sizeof (float));
+			for (i = 0; i < m; i++) q[i] = (scale > 0.) ? (int16_t) lrint (xj[i] / (double) scale) : 0;
+			break;
+		}
+		default:
+			memcpy (rec, xj, (size_t) m * sizeof (double));
+			break;
+	}
+	return;
+}
+
+/*** hash of buf of len bytes, which is used as the checksum of the tiles of the kernel matrix container.
+ * This is FNV-1a over 64-bit words (the tail is processed byte by byte),
+ * and is continued from hash, so that the hash of several buffers is calculated by
+ * hash = mm_real_xmatfile_hash (buf2, len2, mm_real_xmatfile_hash (buf1, len1, MM_REAL_XMATFILE_HASH_INIT)) ***/
+uint64_t
+mm_real_xmatfile_hash (const void *buf, const size_t len, uint64_t hash)
+{
+	size_t			k;
+	const uint64_t	prime = 0x100000001b3ULL;
+	const char		*p = (const char *) buf;
+	for (k = 0; k + sizeof (uint64_t) <= len; k += sizeof (uint64_t)) {
+		uint64_t	w;
+		memcpy (&w, p + k, sizeof (uint64_t));
+		hash = (hash ^ w) * prime;
+	}
+	for (; k < len; k++) hash = (hash ^ (uint64_t) (unsigned char) p[k]) * prime;
+	return hash;
+}
+
+/* magic number at the head of the kernel matrix container */
+static const char	xmatfile_magic[8] = { 'L', '1', 'L', '2', 'X', 'M', 'A', 'T' };
+
+/* size of the header of the kernel matrix container in bytes, except for the padding */
+static size_t
+xmatfile_header_size (const int n, const int ntiles)
+{
+	return sizeof (xmatfile_magic) + 8 * sizeof (int32_t) + 3 * sizeof (uint64_t)
+		+ (size_t) ntiles * sizeof (uint64_t) + 2 * (size_t) n * sizeof (double);
+}
+
+/* size in bytes of a column of X of size m stored in the container of format,
+ * whose rows are divided into the row blocks of rowblock rows.
+ * This is the sum of the records of the row blocks, which differs from
+ * mm_real_xmatfile_record_size (format, m) only if each record has its own scale */
+static size_t
+xmatfile_column_size (const MMRealXmatFormat format, const int m, const int rowblock)
+{
+	int		nb = (m + rowblock - 1) / rowblock;
+	return (size_t) (nb - 1) * mm_real_xmatfile_record_size (format, rowblock)
+		+ mm_real_xmatfile_record_size (format, m - (nb - 1) * rowblock);
+}
+
+/* allocate header of the kernel matrix container */
+static mm_real_xmatfile_header *
+mm_real_xmatfile_header_alloc (const int n, const int ntiles)
+{
+	mm_real_xmatfile_header	*h = (mm_real_xmatfile_header *) malloc (sizeof (mm_real_xmatfile_header));
+	if (h == NULL) error_and_exit ("mm_real_xmatfile_header_alloc", "failed to allocate object.", __FILE__, __LINE__);
+	h->checksum = (uint64_t *) malloc (ntiles * sizeof (uint64_t));
+	h->sx = (double *) malloc (n * sizeof (double));
+	h->xtx = (double *) malloc (n * sizeof (double));
+	if (h->checksum == NULL || h->sx == NULL || h->xtx == NULL)
+		error_and_exit ("mm_real_xmatfile_header_alloc", "cannot allocate memory.", __FILE__, __LINE__);
+	return h;
+}
+
+/*** create new header of the kernel matrix container of X of size m x n, stored in format
+ * by tiles of tile columns, whose rows are divided into row blocks of rowblock rows.
+ * If rowblock <= 0 or rowblock >= m, the rows are not divided, i.e. the columns are stored in order.
+ * fingerprint identifies the settings which X is calculated from,
+ * so that the container is reused only for the same settings.
+ * checksum, sx and xtx are allocated and must be set by the user ***/
+mm_real_xmatfile_header *
+mm_real_xmatfile_header_new (const MMRealXmatFormat format, const int m, const int n,
+	const int tile, const int rowblock, const uint64_t fingerprint)
+{
+	size_t					size;
+	mm_real_xmatfile_header	*h;
+
+	if (m <= 0 || n <= 0) error_and_exit ("mm_real_xmatfile_header_new", "m, n must be > 0.", __FILE__, __LINE__);
+	if (tile <= 0) error_and_exit ("mm_real_xmatfile_header_new", "size of tile must be > 0.", __FILE__, __LINE__);
+
+	h = mm_real_xmatfile_header_alloc (n, (n + tile - 1) / tile);
+	h->version = MM_REAL_XMATFILE_VERSION;
+	h->format = format;
+	h->m = m;
+	h->n = n;
+	h->tile = (tile < n) ? tile : n;
+	h->ntiles = (n + h->tile - 1) / h->tile;
+	h->rowblock = (0 < rowblock && rowblock < m) ? rowblock : m;
+	h->nrowblocks = (m + h->rowblock - 1) / h->rowblock;
+	h->fingerprint = fingerprint;
+	h->reclen = xmatfile_column_size (format, m, h->rowblock);
+	// the tiles start at the aligned offset, so that the mapped columns are aligned
+	size = xmatfile_header_size (n, h->ntiles);
+	h->offset = ((size + MM_REAL_XMATFILE_ALIGN - 1) / MM_REAL_XMATFILE_ALIGN) * MM_REAL_XMATFILE_ALIGN;
+	return h;
+}
+
+/*** free header of the kernel matrix container ***/
+void
+mm_real_xmatfile_header_free (mm_real_xmatfile_header *h)
+{
+	if (h) {
+		if (h->checksum) free (h->checksum);
+		if (h->sx) free (h->sx);
+		if (h->xtx) free (h->xtx);
+		free (h);
+	}
+	return;
+}
+
+/*** write header at the head of the kernel matrix container fp.
+ * This should be called after all tiles are written,
+ * so that the container interrupted while it is written has no valid header ***/
+void
+mm_real_xmatfile_header_write (FILE *fp, const mm_real_xmatfile_header *h)
+{
+	int32_t		iv[8];
+	uint64_t	uv[3];
+	size_t		ret = 0;
+
+	iv[0] = h->version;
+	iv[1] = (int32_t) h->format;
+	iv[2] = h->m;
+	iv[3] = h->n;
+	iv[4] = h->tile;
+	iv[5] = h->ntiles;
+	iv[6] = h->rowblock;
+	iv[7] = h->nrowblocks;
+	uv[0] = h->fingerprint;
+	uv[1] = h->reclen;
+	uv[2] = h->offset;
+
+	if (fseeko (fp, 0, SEEK_SET) != 0) error_and_exit ("mm_real_xmatfile_header_write", "failed to seek xmat file.", __FILE__, __LINE__);
+	ret += fwrite (xmatfile_magic, sizeof (xmatfile_magic), 1, fp);
+	ret += fwrite (iv, sizeof (iv), 1, fp);
+	ret += fwrite (uv, sizeof (uv), 1, fp);
+	ret += fwrite (h->checksum, h->ntiles * sizeof (uint64_t), 1, fp);
+	ret += fwrite (h->sx, h->n * sizeof (double), 1, fp);
+	ret += fwrite (h->xtx, h->n * sizeof (double), 1, fp);
+	if (ret != 6 || fflush (fp) != 0) error_and_exit ("mm_real_xmatfile_header_write", "failed to write header of xmat file.", __FILE__, __LINE__);
+	return;
+}
+
+/*** read header of the kernel matrix container fp.
+ * Return NULL if fp is not the container, of other version, or is truncated ***/
+mm_real_xmatfile_header *
+mm_real_xmatfile_header_read (FILE *fp)
+{
+	char					magic[sizeof (xmatfile_magic)];
+	int32_t					iv[8];
+	uint64_t				uv[3];
+	struct stat				st;
+	mm_real_xmatfile_header	*h;
+
+	if (fseeko (fp, 0, SEEK_SET) != 0) return NULL;
+	if (fread (magic, sizeof (magic), 1, fp) != 1 || memcmp (magic, xmatfile_magic, sizeof (magic)) != 0) return NULL;
+	if (fread (iv, sizeof (iv), 1, fp) != 1 || fread (uv, sizeof (uv), 1, fp) != 1) return NULL;
+	if (iv[0] != MM_REAL_XMATFILE_VERSION) return NULL;
+	if (iv[1] < MM_REAL_XMAT_FLOAT64 || MM_REAL_XMAT_INT16 < iv[1]) return NULL;
+	if (iv[2] <= 0 || iv[3] <= 0 || iv[4] <= 0 || iv[5] != (iv[3] + iv[4] - 1) / iv[4]) return NULL;
+	if (iv[6] <= 0 || iv[2] < iv[6] || iv[7] != (iv[2] + iv[6] - 1) / iv[6]) return NULL;
+
+	h = mm_real_xmatfile_header_alloc (iv[3], iv[5]);
+	h->version = iv[0];
+	h->format = (MMRealXmatFormat) iv[1];
+	h->m = iv[2];
+	h->n = iv[3];
+	h->tile = iv[4];
+	h->ntiles = iv[5];
+	h->rowblock = iv[6];
+	h->nrowblocks = iv[7];
+	h->fingerprint = uv[0];
+	h->reclen = (size_t) uv[1];
+	h->offset = (size_t) uv[2];
+
+	if (fread (h->checksum, h->ntiles * sizeof (uint64_t), 1, fp) != 1
+		|| fread (h->sx, h->n * sizeof (double), 1, fp) != 1
+		|| fread (h->xtx, h->n * sizeof (double), 1, fp) != 1
+		|| h->reclen != xmatfile_column_size (h->format, h->m, h->rowblock)
+		|| h->offset < xmatfile_header_size (h->n, h->ntiles)
+		|| fstat (fileno (fp), &st) != 0
+		|| (size_t) st.st_size < h->offset + (size_t) h->n * h->reclen) {
+		mm_real_xmatfile_header_free (h);
+		return NULL;
+	}
+	return h;
+}
+
+/*** offset of t-th tile in the kernel matrix container in bytes ***/
+size_t
+mm_real_xmatfile_tile_offset (const mm_real_xmatfile_header *h, const int t)
+{
+	return h->offset + (size_t) t * h->tile * h->reclen;
+}
+
+/*** num of columns of t-th tile ***/
+int
+mm_real_xmatfile_tile_ncols (const mm_real_xmatfile_header *h, const int t)
+{
+	int		j0 = t * h->tile;
+	return (h->n - j0 < h->tile) ? h->n - j0 : h->tile;
+}
+
+/*** num of rows of b-th row block ***/
+int
+mm_real_xmatfile_block_nrows (const mm_real_xmatfile_header *h, const int b)
+{
+	int		i0 = b * h->rowblock;
+	return (h->m - i0 < h->rowblock) ? h->m - i0 : h->rowblock;
+}
+
+/*** offset in bytes of the record of b-th row block of j-th column from the head of its tile.
+ * The row blocks preceding b-th one are full, so that they are of the same size ***/
+size_t
+mm_real_xmatfile_record_offset (const mm_real_xmatfile_header *h, const int j, const int b)
+{
+	int		t = j / h->tile;
+	int		nc = mm_real_xmatfile_tile_ncols (h, t);
+	return (size_t) nc * b * mm_real_xmatfile_record_size (h->format, h->rowblock)
+		+ (size_t) (j - t * h->tile) * mm_real_xmatfile_record_size (h->format, mm_real_xmatfile_block_nrows (h, b));
+}
+
+/*** num of columns of a tile of the kernel matrix container of format,
+ * such that a tile is at most size bytes, or a row block of a tile is at most size bytes
+ * if the rows of X (size m) are divided into row blocks of rowblock rows (0 < rowblock < m).
+ * So the tile has several columns even if a column of huge m exceeds size. At least 1 ***/
+int
+mm_real_xmatfile_tile_width (const MMRealXmatFormat format, const int m, const int rowblock, const size_t size)
+{
+	int		mb = (0 < rowblock && rowblock < m) ? rowblock : m;
+	size_t	tile = size / mm_real_xmatfile_record_size (format, mb);
+	return (tile < 1) ? 1 : (tile < INT_MAX) ? (int) tile : INT_MAX;
+}
+
+/*** size in bytes of b-th row block of t-th tile, which is placed at
+ * mm_real_xmatfile_tile_offset (h, t) + mm_real_xmatfile_record_offset (h, t * h->tile, b) ***/
+size_t
+mm_real_xmatfile_block_size (const mm_real_xmatfile_header *h, const int t, const int b)
+{
+	return (size_t) mm_real_xmatfile_tile_ncols (h, t) * mm_real_xmatfile_record_size (h->format, mm_real_xmatfile_block_nrows (h, b));
+}
+
+/*** verify the checksums of all tiles of the kernel matrix container fp.
+ * The checksum of a tile is the hash continued over its row blocks in order,
+ * so a row block is read at once, and only a row block of a tile is held ***/
+bool
+mm_real_xmatfile_verify (FILE *fp, const mm_real_xmatfile_header *h)
+{
+	int		t;
+	bool	valid = true;
+	char	*buf = (char *) malloc ((size_t) h->tile * mm_real_xmatfile_record_size (h->format, h->rowblock));
+	if (buf == NULL) error_and_exit ("mm_real_xmatfile_verify", "cannot allocate memory.", __FILE__, __LINE__);
+	for (t = 0; t < h->ntiles && valid; t++) {
+		int			b;
+		uint64_t	hash = MM_REAL_XMATFILE_HASH_INIT;
+		for (b = 0; b < h->nrowblocks && valid; b++) {
+			size_t	len = mm_real_xmatfile_block_size (h, t, b);
+			size_t	done = 0;
+			off_t	offset = (off_t) (mm_real_xmatfile_tile_offset (h, t) + mm_real_xmatfile_record_offset (h, t * h->tile, b));
+			while (done < len) {
+				ssize_t	ret = pread (fileno (fp), buf + done, len - done, offset + (off_t) done);
+				if (ret <= 0) break;
+				done += (size_t) ret;
+			}
+			valid = (done == len);
+			hash = mm_real_xmatfile_hash (buf, len, hash);
+		}
+		valid = (valid && hash == h->checksum[t]);
+	}
+	free (buf);
+	return valid;
+}
+
+/* num of elements converted at once in mm_real_xmatfile_decode */
+#define XMATFILE_CHUNK	512
+
+/*** decode the record rec of the xmat file of format into xj (size m).
+ * rec may be placed at the tail of xj, so that a record is read and decoded in place:
+ * each chunk of rec is copied to the local buffer before it is converted,
+ * and the converted chunk does not reach the following chunks of rec.
+ * The conversion loops are plain loops over the local buffer,
+ * so that they are vectorized by the compiler ***/
+void
+mm_real_xmatfile_decode (const MMRealXmatFormat format, const int m, const void *rec, double *xj)
+{
+	int			i, k;
+	const char	*src = (const char *) rec;
+
+	switch (format) {
+		case MM_REAL_XMAT_FLOAT32:
+		{
+			float	t[XMATFILE_CHUNK];
+			for (i = 0; i < m; i += XMATFILE_CHUNK) {
+				int		len = (m - i < XMATFILE_CHUNK) ? m - i : XMATFILE_CHUNK;
+				memcpy (t, src + (size_t) i * sizeof (float), len * sizeof (float));
+				for (k = 0; k < len; k++) xj[i + k] = (double) t[k];
+			}
+			break;
+		}
+		case MM_REAL_XMAT_INT16:
+		{
+			float	scale;
+			int16_t	t[XMATFILE_CHUNK];
+			memcpy (&scale, src, sizeof (float));
+			src += sizeof (float);
+			for (i = 0; i < m; i += XMATFILE_CHUNK) {
+				int		len = (m - i < XMATFILE_CHUNK) ? m - i : XMATFILE_CHUNK;
+				memcpy (t, src + (size_t) i * sizeof (int16_t), len * sizeof (int16_t));
+				for (k = 0; k < len; k++) xj[i + k] = (double) scale * (double) t[k];
+			}
+			break;
+		}
+		default:
+			if (src != (const char *) xj) memcpy (xj, src, (size_t) m * sizeof (double));
+			break;
+	}
+	return;
+}
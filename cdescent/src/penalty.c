@@ -0,0 +1,288 @@
+/*
+ * penalty.c
+ *
+ *  Created on: 2026/10/18
+ *      Author: utsugi
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <cdescent.h>
+#include <penalty.h>
+
+#include "private/private.h"
+#include "private/atomic.h"
+
+/* maximum number of non-zero elements of a column of implicit D: E, Dx, Dy and Dz */
+#define PENALTY_MAX_NNZ	7
+
+/* allocate penalty object */
+static penalty *
+penalty_alloc (void)
+{
+	penalty	*p = (penalty *) malloc (sizeof (penalty));
+	if (p == NULL) return NULL;
+
+	p->type = PENALTY_MATRIX;
+	p->m = 0;
+	p->n = 0;
+
+	p->d = NULL;
+
+	p->nx = 0;
+	p->ny = 0;
+	p->nz = 0;
+	p->w[0] = p->w[1] = p->w[2] = p->w[3] = 0.;
+
+	p->scale = NULL;
+
+	return p;
+}
+
+/*** create new penalty object of matrix d.
+ * d is not copied, and is not freed by penalty_free ***/
+penalty *
+penalty_new_matrix (mm_real *d)
+{
+	penalty	*p;
+	if (!d) error_and_exit ("penalty_new_matrix", "d is empty.", __FILE__, __LINE__);
+	p = penalty_alloc ();
+	if (p == NULL) error_and_exit ("penalty_new_matrix", "failed to allocate object.", __FILE__, __LINE__);
+	p->type = PENALTY_MATRIX;
+	p->m = d->m;
+	p->n = d->n;
+	p->d = d;
+	return p;
+}
+
+/*** create new penalty object D = w0 * E of size n x n ***/
+penalty *
+penalty_new_identity (const int n, const double w0)
+{
+	penalty	*p;
+	if (n <= 0) error_and_exit ("penalty_new_identity", "n must be > 0.", __FILE__, __LINE__);
+	p = penalty_alloc ();
+	if (p == NULL) error_and_exit ("penalty_new_identity", "failed to allocate object.", __FILE__, __LINE__);
+	p->type = PENALTY_IDENTITY;
+	p->m = n;
+	p->n = n;
+	p->w[0] = w0;
+	return p;
+}
+
+/*** create new penalty object of the first-difference stencils on nx x ny x nz grid
+ *     D = [w0 * E; wx * Dx; wy * Dy; wz * Dz],
+ * which is the same as mm_real_smooth_l01_1 (or mm_real_smooth_1 if w0 = 0, then w0 * E is omitted).
+ * Each block is n x n, where n = nx * ny * nz, and the cell j = i + jj * nx + k * nx * ny
+ * has +w on its own row and -w on the row of the next cell along the axis, if exists ***/
+penalty *
+penalty_new_stencil (const int nx, const int ny, const int nz,
+	const double w0, const double wx, const double wy, const double wz)
+{
+	penalty	*p;
+	if (nx <= 0 || ny <= 0 || nz <= 0) error_and_exit ("penalty_new_stencil", "size of grid must be > 0.", __FILE__, __LINE__);
+	p = penalty_alloc ();
+	if (p == NULL) error_and_exit ("penalty_new_stencil", "failed to allocate object.", __FILE__, __LINE__);
+	p->type = PENALTY_STENCIL;
+	p->nx = nx;
+	p->ny = ny;
+	p->nz = nz;
+	p->n = nx * ny * nz;
+	p->m = ((w0 != 0.) ? 4 : 3) * p->n;
+	p->w[0] = w0;
+	p->w[1] = wx;
+	p->w[2] = wy;
+	p->w[3] = wz;
+	return p;
+}
+
+/*** copy penalty object. D of PENALTY_MATRIX is shared ***/
+penalty *
+penalty_copy (const penalty *p)
+{
+	penalty	*q = penalty_alloc ();
+	if (q == NULL) error_and_exit ("penalty_copy", "failed to allocate object.", __FILE__, __LINE__);
+	memcpy (q, p, sizeof (penalty));
+	if (p->scale) {
+		q->scale = (double *) malloc (p->n * sizeof (double));
+		if (q->scale == NULL) error_and_exit ("penalty_copy", "cannot allocate memory.", __FILE__, __LINE__);
+		memcpy (q->scale, p->scale, p->n * sizeof (double));
+	}
+	return q;
+}
+
+/*** free penalty object ***/
+void
+penalty_free (penalty *p)
+{
+	if (p) {
+		if (p->scale) free (p->scale);
+		free (p);
+	}
+	return;
+}
+
+/*** whether D is not stored ***/
+bool
+penalty_is_implicit (const penalty *p)
+{
+	return (p->type != PENALTY_MATRIX);
+}
+
+/*** D(:,j) = alpha * D(:,j) ***/
+void
+penalty_scale_column (penalty *p, const int j, const double alpha)
+{
+	if (j < 0 || p->n <= j) error_and_exit ("penalty_scale_column", "index out of range.", __FILE__, __LINE__);
+	if (p->type == PENALTY_MATRIX) {
+		mm_real_xj_scale (p->d, j, alpha);
+		return;
+	}
+	if (p->scale == NULL) {
+		int		k;
+		p->scale = (double *) malloc (p->n * sizeof (double));
+		if (p->scale == NULL) error_and_exit ("penalty_scale_column", "cannot allocate memory.", __FILE__, __LINE__);
+		for (k = 0; k < p->n; k++) p->scale[k] = 1.;
+	}
+	p->scale[j] *= alpha;
+	return;
+}
+
+/* non-zero elements of j-th column of implicit D: row indices r and values v.
+ * The order of the elements is the same as the CSC of mm_real_smooth_l01_1,
+ * and the values are w * scale[j], so that the results agree with stored D.
+ * return the number of the elements */
+static int
+penalty_column (const penalty *p, const int j, int *r, double *v)
+{
+	int		l = 0;
+	int		nx, nh;
+	int		off = 0;
+	double	s = (p->scale) ? p->scale[j] : 1.;
+	double	ws;
+
+	if (p->w[0] != 0.) {
+		r[l] = j;
+		v[l++] = p->w[0] * s;
+		off = p->n;
+	}
+	if (p->type == PENALTY_IDENTITY) return l;
+
+	nx = p->nx;
+	nh = nx * p->ny;
+	// Dx: next cell is j + 1
+	ws = p->w[1] * s;
+	r[l] = off + j;
+	v[l++] = ws;
+	if (j % nx < nx - 1) {
+		r[l] = off + j + 1;
+		v[l++] = - ws;
+	}
+	off += p->n;
+	// Dy: next cell is j + nx
+	ws = p->w[2] * s;
+	r[l] = off + j;
+	v[l++] = ws;
+	if ((j % nh) / nx < p->ny - 1) {
+		r[l] = off + j + nx;
+		v[l++] = - ws;
+	}
+	off += p->n;
+	// Dz: next cell is j + nh
+	ws = p->w[3] * s;
+	r[l] = off + j;
+	v[l++] = ws;
+	if (j / nh < p->nz - 1) {
+		r[l] = off + j + nh;
+		v[l++] = - ws;
+	}
+	return l;
+}
+
+/*** return D(:,j)' * D(:,j) ***/
+double
+penalty_dj_ssq (const penalty *p, const int j)
+{
+	int		r[PENALTY_MAX_NNZ];
+	double	v[PENALTY_MAX_NNZ];
+	int		l;
+	if (p->type == PENALTY_MATRIX) return mm_real_xj_ssq (p->d, j);
+	l = penalty_column (p, j, r, v);
+	return ddot_ (&l, v, &ione, v, &ione);
+}
+
+/*** return D(:,j)' * y ***/
+double
+penalty_dj_trans_dot_y (const penalty *p, const int j, const mm_dense *y)
+{
+	int		k, l;
+	int		r[PENALTY_MAX_NNZ];
+	double	v[PENALTY_MAX_NNZ];
+	double	val = 0.;
+	if (p->type == PENALTY_MATRIX) return mm_real_xj_trans_dot_yk (p->d, j, y, 0);
+	l = penalty_column (p, j, r, v);
+	for (k = 0; k < l; k++) val += v[k] * y->data[r[k]];
+	return val;
+}
+
+/*** y = alpha * D(:,j) + y ***/
+void
+penalty_adjpy (const double alpha, const penalty *p, const int j, mm_dense *y)
+{
+	int		k, l;
+	int		r[PENALTY_MAX_NNZ];
+	double	v[PENALTY_MAX_NNZ];
+	if (p->type == PENALTY_MATRIX) {
+		mm_real_axjpy (alpha, p->d, j, y);
+		return;
+	}
+	l = penalty_column (p, j, r, v);
+	for (k = 0; k < l; k++) y->data[r[k]] += alpha * v[k];
+	return;
+}
+
+/*** y = alpha * D(:,j) + y, atomic ***/
+void
+penalty_adjpy_atomic (const double alpha, const penalty *p, const int j, mm_dense *y)
+{
+	int		k, l;
+	int		r[PENALTY_MAX_NNZ];
+	double	v[PENALTY_MAX_NNZ];
+	if (p->type == PENALTY_MATRIX) {
+		mm_real_axjpy_atomic (alpha, p->d, j, y);
+		return;
+	}
+	l = penalty_column (p, j, r, v);
+	for (k = 0; k < l; k++) atomic_add (y->data + r[k], alpha * v[k]);
+	return;
+}
+
+/*** z = alpha * D * y + beta * z, or z = alpha * D' * y + beta * z if trans ***/
+void
+penalty_dot_y (const bool trans, const double alpha, const penalty *p, const mm_dense *y,
+	const double beta, mm_dense *z)
+{
+	int		j, k, l;
+	int		m;
+	int		r[PENALTY_MAX_NNZ];
+	double	v[PENALTY_MAX_NNZ];
+	if (p->type == PENALTY_MATRIX) {
+		mm_real_x_dot_yk (trans, alpha, p->d, y, 0, beta, z);
+		return;
+	}
+	m = (!trans) ? p->m : p->n;
+	if (fabs (beta) > DBL_EPSILON) dscal_ (&m, &beta, z->data, &ione);
+	else mm_real_set_all (z, 0.);
+
+	// same order of operations as mm_real_x_dot_yk for sparse D
+	for (j = 0; j < p->n; j++) {
+		l = penalty_column (p, j, r, v);
+		if (trans) {
+			for (k = 0; k < l; k++) z->data[j] += alpha * v[k] * y->data[r[k]];
+		} else {
+			for (k = 0; k < l; k++) z->data[r[k]] += alpha * v[k] * y->data[j];
+		}
+	}
+	return;
+}
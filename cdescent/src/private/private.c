@@ -30,3 +30,108 @@ printf_warning (const char * function_name, const char *error_msg, const char *f
 	fprintf (stderr, "WARNING: %s: %s:%d: %s\n", function_name, file, line, error_msg);
 	return;
 }
+
+/* range [*start, *start + *len) of 0, ..., n - 1 assigned to thread tid of nth threads.
+ * This is the same partition as "omp for schedule(static)" without chunk size,
+ * i.e. the first n % nth threads have n / nth + 1 elements and the others have n / nth */
+void
+static_partition (const int n, const int nth, const int tid, int *start, int *len)
+{
+	int		q = n / nth;
+	int		r = n % nth;
+	*len = (tid < r) ? q + 1 : q;
+	*start = tid * q + ((tid < r) ? tid : r);
+	return;
+}
+
+/* distance of software prefetch in number of elements */
+#ifndef PREFETCH_DISTANCE
+#define PREFETCH_DISTANCE	64
+#endif
+
+/* y = alpha * x + y and return z' * y of updated y, which are done in one pass over y.
+ * x, y and z are of size n, and no argument is checked */
+double
+axpy_dot (const int n, const double alpha, const double *x, const double *z, double *y)
+{
+	int		i;
+	int		n4 = n - n % 4;
+	// partial sums, so as the additions are not serialized
+	double	s0 = 0.;
+	double	s1 = 0.;
+	double	s2 = 0.;
+	double	s3 = 0.;
+
+	for (i = 0; i < n4; i += 4) {
+#ifdef __GNUC__
+		if (i % 8 == 0) {
+			__builtin_prefetch (x + i + PREFETCH_DISTANCE, 0, 0);
+			__builtin_prefetch (z + i + PREFETCH_DISTANCE, 0, 0);
+			__builtin_prefetch (y + i + PREFETCH_DISTANCE, 1, 0);
+		}
+#endif
+		y[i] += alpha * x[i];
+		y[i + 1] += alpha * x[i + 1];
+		y[i + 2] += alpha * x[i + 2];
+		y[i + 3] += alpha * x[i + 3];
+		s0 += z[i] * y[i];
+		s1 += z[i + 1] * y[i + 1];
+		s2 += z[i + 2] * y[i + 2];
+		s3 += z[i + 3] * y[i + 3];
+	}
+	for (; i < n; i++) {
+		y[i] += alpha * x[i];
+		s0 += z[i] * y[i];
+	}
+	return (s0 + s1) + (s2 + s3);
+}
+
+/* number of work spaces allocated so far by work_malloc, work_calloc and work_realloc */
+static long	num_work_allocated = 0;
+
+/* malloc of a work space of the solvers, which is counted,
+ * so that the allocations in the loops of the solvers are found by work_num_allocated */
+void *
+work_malloc (const size_t size)
+{
+#pragma omp atomic
+	num_work_allocated++;
+	return malloc (size);
+}
+
+/* calloc of a work space of the solvers, which is counted */
+void *
+work_calloc (const size_t nmemb, const size_t size)
+{
+#pragma omp atomic
+	num_work_allocated++;
+	return calloc (nmemb, size);
+}
+
+/* realloc of a work space of the solvers, which is counted */
+void *
+work_realloc (void *ptr, const size_t size)
+{
+#pragma omp atomic
+	num_work_allocated++;
+	return realloc (ptr, size);
+}
+
+/* return the number of work spaces allocated so far */
+long
+work_num_allocated (void)
+{
+	long	num;
+#pragma omp atomic read
+	num = num_work_allocated;
+	return num;
+}
+
+/* new dense vector of size n, which is set to 0 */
+mm_dense *
+vector_new (const int n)
+{
+	mm_dense	*v = mm_real_new (MM_REAL_DENSE, MM_REAL_GENERAL, n, 1, n);
+	mm_real_set_all (v, 0.);
+	return v;
+}
@@ -0,0 +1,73 @@
+/*
+ * random.c
+ *
+ *  Created on: 2026/10/18
+ *      Author: utsugi
+ */
+
+#include <private/random.h>
+
+/* xoshiro256** by D. Blackman and S. Vigna, http://prng.di.unimi.it/
+ * Each thread has its own state, so no locking is needed unlike rand() */
+
+static inline uint64_t
+rotl (const uint64_t x, int k)
+{
+	return (x << k) | (x >> (64 - k));
+}
+
+/* splitmix64, used to expand a seed to the state of xoshiro256** */
+static uint64_t
+splitmix64 (uint64_t *x)
+{
+	uint64_t	z = (*x += 0x9e3779b97f4a7c15ULL);
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+	return z ^ (z >> 31);
+}
+
+/*** initialize state of the generator by seed ***/
+void
+xoshiro256_init (xoshiro256 *rng, const uint64_t seed)
+{
+	uint64_t	x = seed;
+	rng->s[0] = splitmix64 (&x);
+	rng->s[1] = splitmix64 (&x);
+	rng->s[2] = splitmix64 (&x);
+	rng->s[3] = splitmix64 (&x);
+	return;
+}
+
+/*** return next 64-bit random number ***/
+uint64_t
+xoshiro256_next (xoshiro256 *rng)
+{
+	uint64_t	*s = rng->s;
+	uint64_t	result = rotl (s[1] * 5, 7) * 9;
+	uint64_t	t = s[1] << 17;
+
+	s[2] ^= s[0];
+	s[3] ^= s[1];
+	s[1] ^= s[2];
+	s[0] ^= s[3];
+	s[2] ^= t;
+	s[3] = rotl (s[3], 45);
+
+	return result;
+}
+
+/*** return uniform random integer in [0, n).
+ * the upper 32 bits are mapped by multiplication (Lemire, 2019), bias is negligible for n << 2^32 ***/
+int
+xoshiro256_int (xoshiro256 *rng, const int n)
+{
+	uint64_t	r = xoshiro256_next (rng) >> 32;
+	return (int) ((r * (uint64_t) n) >> 32);
+}
+
+/*** return uniform random number in [0, 1) ***/
+double
+xoshiro256_double (xoshiro256 *rng)
+{
+	return (double) (xoshiro256_next (rng) >> 11) * 0x1.0p-53;
+}
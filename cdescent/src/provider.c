@@ -0,0 +1,1088 @@
+/*
+ * provider.c
+ *
+ *  Created on: 2026/10/19
+ *      Author: utsugi
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <cdescent.h>
+#include <provider.h>
+
+#include "private/private.h"
+#include "private/atomic.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/* allocate provider object */
+static provider *
+provider_alloc (void)
+{
+	provider	*p = (provider *) malloc (sizeof (provider));
+	if (p == NULL) return NULL;
+
+	p->type = PROVIDER_MATRIX;
+	p->m = 0;
+	p->n = 0;
+
+	p->x = NULL;
+
+	p->format = MM_REAL_XMAT_FLOAT64;
+	p->reclen = 0;
+	p->offset = 0;
+	p->tile = 0;
+	p->rowblock = 0;
+	p->fp = NULL;
+	p->map = NULL;
+	p->maplen = 0;
+
+	p->func = NULL;
+	p->data = NULL;
+
+	p->sx = NULL;
+	p->xtx = NULL;
+
+	p->scale = NULL;
+	p->pool = NULL;
+
+	return p;
+}
+
+/*** create new provider of X stored in mm_real, dense or sparse.
+ * x is not copied, and is not freed by provider_free ***/
+provider *
+provider_new_matrix (mm_real *x)
+{
+	provider	*p;
+	if (!x) error_and_exit ("provider_new_matrix", "x is empty.", __FILE__, __LINE__);
+	p = provider_alloc ();
+	if (p == NULL) error_and_exit ("provider_new_matrix", "failed to allocate object.", __FILE__, __LINE__);
+	p->type = PROVIDER_MATRIX;
+	p->m = x->m;
+	p->n = x->n;
+	p->x = x;
+	return p;
+}
+
+/*****************************************
+ *  pool of column buffers of out-of-core X  *
+ *****************************************/
+
+/* create new pool of column buffers of X of size m x n.
+ * The number of buffers is the largest one whose size does not exceed budget bytes,
+ * and is at most n. If budget is less than the size of one column,
+ * no column is kept resident and each access reads the column into the buffer of the thread */
+static xjpool *
+xjpool_new (const int m, const int n, const size_t budget)
+{
+	int		k;
+	size_t	nslots = budget / ((size_t) m * sizeof (double));
+	xjpool	*pool = (xjpool *) malloc (sizeof (xjpool));
+	if (pool == NULL) error_and_exit ("xjpool_new", "failed to allocate object.", __FILE__, __LINE__);
+
+	pool->nslots = (nslots < (size_t) n) ? (int) nslots : n;
+	pool->head = -1;
+	pool->tail = -1;
+	pool->nhits = 0;
+	pool->nreads = 0;
+	pool->nresident = 0;
+
+	pthread_mutex_init (&pool->lock, NULL);
+	pthread_cond_init (&pool->loaded, NULL);
+
+	pool->nahead = 0;
+	pool->ahead_from = -1;
+	pool->ahead_stop = false;
+	pthread_cond_init (&pool->ahead_cond, NULL);
+
+	pool->data = NULL;
+	pool->owner = NULL;
+	pool->pin = NULL;
+	pool->loading = NULL;
+	pool->prev = NULL;
+	pool->next = NULL;
+
+	pool->xbcols = 0;
+	pool->xbblock = NULL;
+	pool->xbraw = NULL;
+	pool->xbc = NULL;
+
+	// buffer of each thread, used if the column is not resident in a slot
+#ifdef _OPENMP
+	pool->nthreads = omp_get_max_threads ();
+#else
+	pool->nthreads = 1;
+#endif
+	pool->buf = (double *) malloc ((size_t) m * pool->nthreads * sizeof (double));
+	pool->slot = (int *) malloc (n * sizeof (int));
+	if (pool->buf == NULL || pool->slot == NULL) error_and_exit ("xjpool_new", "cannot allocate memory.", __FILE__, __LINE__);
+	for (k = 0; k < n; k++) pool->slot[k] = -1;
+
+	if (pool->nslots > 0) {
+		pool->data = (double *) malloc ((size_t) m * pool->nslots * sizeof (double));
+		pool->owner = (int *) malloc (pool->nslots * sizeof (int));
+		pool->pin = (int *) malloc (pool->nslots * sizeof (int));
+		pool->loading = (bool *) malloc (pool->nslots * sizeof (bool));
+		pool->prev = (int *) malloc (pool->nslots * sizeof (int));
+		pool->next = (int *) malloc (pool->nslots * sizeof (int));
+		if (pool->data == NULL || pool->owner == NULL || pool->pin == NULL || pool->loading == NULL
+			|| pool->prev == NULL || pool->next == NULL)
+			error_and_exit ("xjpool_new", "cannot allocate memory.", __FILE__, __LINE__);
+		// all slots are empty and linked in order
+		for (k = 0; k < pool->nslots; k++) {
+			pool->owner[k] = -1;
+			pool->pin[k] = 0;
+			pool->loading[k] = false;
+			pool->prev[k] = k - 1;
+			pool->next[k] = (k < pool->nslots - 1) ? k + 1 : -1;
+		}
+		pool->head = 0;
+		pool->tail = pool->nslots - 1;
+	}
+	return pool;
+}
+
+/* free pool of column buffers, and stop the read-ahead thread */
+static void
+xjpool_free (xjpool *pool)
+{
+	if (pool) {
+		if (pool->nahead > 0) {
+			pthread_mutex_lock (&pool->lock);
+			pool->ahead_stop = true;
+			pthread_cond_signal (&pool->ahead_cond);
+			pthread_mutex_unlock (&pool->lock);
+			pthread_join (pool->ahead_thread, NULL);
+		}
+		pthread_mutex_destroy (&pool->lock);
+		pthread_cond_destroy (&pool->loaded);
+		pthread_cond_destroy (&pool->ahead_cond);
+		if (pool->buf) free (pool->buf);
+		if (pool->data) free (pool->data);
+		if (pool->slot) free (pool->slot);
+		if (pool->owner) free (pool->owner);
+		if (pool->pin) free (pool->pin);
+		if (pool->loading) free (pool->loading);
+		if (pool->prev) free (pool->prev);
+		if (pool->next) free (pool->next);
+		if (pool->xbblock) free (pool->xbblock);
+		if (pool->xbraw) free (pool->xbraw);
+		if (pool->xbc) free (pool->xbc);
+		free (pool);
+	}
+	return;
+}
+
+/* num of row blocks of the container */
+static int
+xmatfile_nrowblocks (const provider *p)
+{
+	return (p->m + p->rowblock - 1) / p->rowblock;
+}
+
+/* num of rows of b-th row block of the container */
+static int
+xmatfile_block_nrows (const provider *p, const int b)
+{
+	int		i0 = b * p->rowblock;
+	return (p->m - i0 < p->rowblock) ? p->m - i0 : p->rowblock;
+}
+
+/* offset in the container of the record of b-th row block of j-th column
+ * (see mm_real_xmatfile_record_offset), which is offset + j * reclen if the rows are not divided */
+static size_t
+xmatfile_record_offset (const provider *p, const int j, const int b)
+{
+	int		j0 = (j / p->tile) * p->tile;
+	int		nc = (p->n - j0 < p->tile) ? p->n - j0 : p->tile;
+	return p->offset + (size_t) j0 * p->reclen
+		+ (size_t) nc * b * mm_real_xmatfile_record_size (p->format, p->rowblock)
+		+ (size_t) (j - j0) * mm_real_xmatfile_record_size (p->format, xmatfile_block_nrows (p, b));
+}
+
+/* read j-th column in the container into xj (size m) by pread.
+ * The record of each row block is read into the tail of the rows of xj,
+ * which is large enough for any format, and is decoded in place (see mm_real_xmatfile_decode).
+ * Since pread does not move the file position, the threads can read the container concurrently */
+static void
+xmatfile_read_xj (const provider *p, const int j, double *xj)
+{
+	int		b;
+	int		fd = fileno (p->fp);
+	for (b = 0; b < xmatfile_nrowblocks (p); b++) {
+		int		mb = xmatfile_block_nrows (p, b);
+		double	*xb = xj + (size_t) b * p->rowblock;
+		size_t	len = mm_real_xmatfile_record_size (p->format, mb);
+		off_t	offset = (off_t) xmatfile_record_offset (p, j, b);
+		char	*rec = (char *) xb + (size_t) mb * sizeof (double) - len;
+		size_t	done = 0;
+		while (done < len) {
+			ssize_t	ret = pread (fd, rec + done, len - done, offset + (off_t) done);
+			if (ret <= 0) error_and_exit ("xmatfile_read_xj", "failed to read column of X.", __FILE__, __LINE__);
+			done += (size_t) ret;
+		}
+		mm_real_xmatfile_decode (p->format, mb, rec, xb);
+	}
+	return;
+}
+
+/* load j-th column of out-of-core X into xj: read from the file,
+ * decode from the mapped file, or calculate by the function.
+ * The scale of the column (see provider_scale_column) is not applied */
+static void
+provider_load_unscaled (const provider *p, const int j, double *xj)
+{
+	int		b;
+	switch (p->type) {
+		case PROVIDER_XMATFILE:
+			xmatfile_read_xj (p, j, xj);
+			break;
+		case PROVIDER_XMATFILE_MMAP:
+			for (b = 0; b < xmatfile_nrowblocks (p); b++)
+				mm_real_xmatfile_decode (p->format, xmatfile_block_nrows (p, b),
+					p->map + xmatfile_record_offset (p, j, b), xj + (size_t) b * p->rowblock);
+			break;
+		case PROVIDER_FUNCTION:
+			p->func (j, xj, p->data);
+			break;
+		default:
+			break;
+	}
+	return;
+}
+
+/* load j-th column of out-of-core X into xj, which is the buffer of the calling thread, and scale it */
+static void
+provider_load (const provider *p, const int j, double *xj)
+{
+	double	*scale;
+	provider_load_unscaled (p, j, xj);
+	// p->scale may be published by provider_scale_column of another thread
+#pragma omp atomic read
+	scale = p->scale;
+	if (scale) {
+#pragma omp flush
+		if (scale[j] != 1.) dscal_ (&p->m, scale + j, xj, &ione);
+	}
+	return;
+}
+
+/* move k-th slot to the head of the list, i.e. the most recently used */
+static void
+xjpool_touch (xjpool *pool, const int k)
+{
+	if (pool->head == k) return;
+	// unlink
+	pool->next[pool->prev[k]] = pool->next[k];
+	if (pool->next[k] >= 0) pool->prev[pool->next[k]] = pool->prev[k];
+	else pool->tail = pool->prev[k];
+	// link at the head
+	pool->prev[k] = -1;
+	pool->next[k] = pool->head;
+	pool->prev[pool->head] = k;
+	pool->head = k;
+	return;
+}
+
+/* assign the least recently used slot which is not pinned to j-th column,
+ * pin it and mark it as loading. Return the slot, or -1 if all slots are pinned.
+ * pool->lock must be held */
+static int
+xjpool_reserve (xjpool *pool, const int j)
+{
+	int		s;
+	for (s = pool->tail; s >= 0; s = pool->prev[s]) if (pool->pin[s] == 0) break;
+	if (s < 0) return -1;
+	if (pool->owner[s] >= 0) pool->slot[pool->owner[s]] = -1;
+	else pool->nresident++;
+	pool->owner[s] = j;
+	pool->slot[j] = s;
+	pool->pin[s]++;
+	pool->loading[s] = true;
+	pool->nreads++;
+	xjpool_touch (pool, s);
+	return s;
+}
+
+/* load j-th column into the reserved slot s outside the lock, then scale it and mark it as loaded.
+ * The scale is applied under the lock, since provider_scale_column may change it while loading
+ * (and does not scale the column being loaded).
+ * pool->lock must be held, and is held on return */
+static void
+xjpool_load (const provider *p, const int j, const int s)
+{
+	xjpool	*pool = p->pool;
+	double	*xj = pool->data + (size_t) s * p->m;
+	pthread_mutex_unlock (&pool->lock);
+	provider_load_unscaled (p, j, xj);
+	pthread_mutex_lock (&pool->lock);
+	if (p->scale && p->scale[j] != 1.) dscal_ (&p->m, p->scale + j, xj, &ione);
+	pool->loading[s] = false;
+	pthread_cond_broadcast (&pool->loaded);
+	return;
+}
+
+/* background thread which reads ahead the columns
+ * ahead_from, ahead_from + 1, ..., ahead_from + nahead - 1 (cyclically) into the pool.
+ * If a new request is posted while reading, it restarts from the new position */
+static void *
+xjpool_read_ahead_thread (void *arg)
+{
+	const provider	*p = (const provider *) arg;
+	xjpool			*pool = p->pool;
+
+	pthread_mutex_lock (&pool->lock);
+	while (!pool->ahead_stop) {
+		int		i;
+		int		from = pool->ahead_from;
+		if (from < 0) {
+			pthread_cond_wait (&pool->ahead_cond, &pool->lock);
+			continue;
+		}
+		pool->ahead_from = -1;
+		for (i = 0; i < pool->nahead; i++) {
+			int		s;
+			int		j = (from + i) % p->n;
+			if (pool->ahead_stop || pool->ahead_from >= 0) break;
+			if (pool->slot[j] >= 0) continue;
+			if ((s = xjpool_reserve (pool, j)) < 0) break;
+			xjpool_load (p, j, s);
+			pool->pin[s]--;
+		}
+	}
+	pthread_mutex_unlock (&pool->lock);
+	return NULL;
+}
+
+/* return the buffer of the calling thread and set *k = -1,
+ * or a temporary buffer and set *k = -2 if the thread has no buffer */
+static double *
+xjpool_buffer (const provider *p, int *k)
+{
+	int		t = 0;
+	double	*xj;
+#ifdef _OPENMP
+	t = omp_get_thread_num ();
+#endif
+	if (t < p->pool->nthreads) {
+		*k = -1;
+		return p->pool->buf + (size_t) t * p->m;
+	}
+	*k = -2;
+	xj = (double *) work_malloc (p->m * sizeof (double));
+	if (xj == NULL) error_and_exit ("xjpool_buffer", "cannot allocate memory.", __FILE__, __LINE__);
+	return xj;
+}
+
+/* return j-th column of out-of-core X and pin its slot *k.
+ * If the container is mapped and stored in double, the pointer into the mapped pages is returned.
+ * If the column is being read by another thread, wait for it.
+ * If all slots are pinned by other threads (or the pool has no slot),
+ * the column is loaded into the buffer of the calling thread and *k is set to -1,
+ * or into a temporary buffer and *k is set to -2 if the thread has no buffer */
+static double *
+provider_acquire (const provider *p, const int j, int *k)
+{
+	int		s;
+	double	*xj;
+	xjpool	*pool = p->pool;
+
+	if (p->type == PROVIDER_XMATFILE_MMAP) {
+		// pointer into the mapped file, if the rows are not divided
+		if (p->format == MM_REAL_XMAT_FLOAT64 && !p->scale && p->rowblock == p->m) {
+			*k = -1;
+			return (double *) (p->map + p->offset + (size_t) j * p->reclen);
+		}
+		xj = xjpool_buffer (p, k);
+		provider_load (p, j, xj);
+		return xj;
+	}
+
+	pthread_mutex_lock (&pool->lock);
+	while ((s = pool->slot[j]) >= 0 && pool->loading[s]) pthread_cond_wait (&pool->loaded, &pool->lock);
+	if (s >= 0) {
+		pool->nhits++;
+		pool->pin[s]++;
+		xjpool_touch (pool, s);
+	} else if ((s = xjpool_reserve (pool, j)) >= 0) {
+		xjpool_load (p, j, s);
+	}
+	// request to read ahead the following columns, unless all columns are resident
+	if (pool->nahead > 0 && pool->nresident < p->n) {
+		pool->ahead_from = (j + 1) % p->n;
+		pthread_cond_signal (&pool->ahead_cond);
+	}
+	if (s < 0) pool->nreads++;
+	pthread_mutex_unlock (&pool->lock);
+
+	if (s >= 0) {
+		*k = s;
+		return pool->data + (size_t) s * p->m;
+	}
+
+	xj = xjpool_buffer (p, k);
+	provider_load (p, j, xj);
+	return xj;
+}
+
+/* unpin k-th slot, or free the temporary buffer xj if k = -2 */
+static void
+provider_release (const provider *p, const int k, double *xj)
+{
+	if (k == -1) return;
+	if (k == -2) {
+		free (xj);
+		return;
+	}
+	pthread_mutex_lock (&p->pool->lock);
+	p->pool->pin[k]--;
+	pthread_mutex_unlock (&p->pool->lock);
+	return;
+}
+
+/*******************************
+ *  providers of out-of-core X  *
+ *******************************/
+
+/* open the kernel matrix container fn */
+static provider *
+xmatfile_open (const char *fn)
+{
+	provider				*p;
+	mm_real_xmatfile_header	*h;
+	FILE					*fp = fopen (fn, "rb");
+
+	if (!fp) {
+		char	msg[BUFSIZ];
+		sprintf (msg, "cannot open file %.80s.", fn);
+		error_and_exit ("xmatfile_open", msg, __FILE__, __LINE__);
+	}
+	if ((h = mm_real_xmatfile_header_read (fp)) == NULL) {
+		char	msg[BUFSIZ];
+		sprintf (msg, "%.80s is not a valid xmat file.", fn);
+		error_and_exit ("xmatfile_open", msg, __FILE__, __LINE__);
+	}
+
+	p = provider_alloc ();
+	if (p == NULL) error_and_exit ("xmatfile_open", "failed to allocate object.", __FILE__, __LINE__);
+
+	p->type = PROVIDER_XMATFILE;
+	p->m = h->m;
+	p->n = h->n;
+	p->format = h->format;
+	p->reclen = h->reclen;
+	p->offset = h->offset;
+	p->tile = h->tile;
+	p->rowblock = h->rowblock;
+	p->fp = fp;
+
+	// the columns in the container are normalized, and the statistics of original X are stored with them
+	p->sx = h->sx;
+	p->xtx = h->xtx;
+	h->sx = NULL;
+	h->xtx = NULL;
+	mm_real_xmatfile_header_free (h);
+
+	return p;
+}
+
+/*** create new provider of X stored in the kernel matrix container fn
+ * (see mm_real_xmatfile_header), which holds the normalized columns of X
+ * and the sum and squared norm of the columns before normalized.
+ * The columns used in the coordinate descent are kept resident within
+ * the memory budget (in bytes), and the least recently used one is replaced ***/
+provider *
+provider_new_xmatfile (const char *fn, const size_t budget)
+{
+	provider	*p = xmatfile_open (fn);
+	p->pool = xjpool_new (p->m, p->n, budget);
+	return p;
+}
+
+/*** create new provider which maps the kernel matrix container fn (see provider_new_xmatfile)
+ * into memory read-only. The columns stored in double are served as pointers into the mapped pages
+ * without copy, so the page cache of OS works as the cache of the columns,
+ * and the pages are shared by the processes which map the same container ***/
+provider *
+provider_new_xmatfile_mmap (const char *fn)
+{
+	void		*addr;
+	provider	*p = xmatfile_open (fn);
+
+	p->type = PROVIDER_XMATFILE_MMAP;
+	// no slot, only the buffers of the threads are used to decode the columns
+	p->pool = xjpool_new (p->m, p->n, 0);
+
+	// size of the container is checked by mm_real_xmatfile_header_read
+	p->maplen = p->offset + (size_t) p->n * p->reclen;
+	addr = mmap (NULL, p->maplen, PROT_READ, MAP_SHARED, fileno (p->fp), 0);
+	if (addr == MAP_FAILED) error_and_exit ("provider_new_xmatfile_mmap", "failed to map xmat file.", __FILE__, __LINE__);
+	p->map = (char *) addr;
+	return p;
+}
+
+/*** create new provider of X of m x n whose columns are calculated on the fly
+ * by func (j, xj, data). The calculated columns are kept resident within
+ * the memory budget (in bytes) as provider_new_xmatfile ***/
+provider *
+provider_new_function (const int m, const int n, provider_column_func func, void *data, const size_t budget)
+{
+	provider	*p;
+	if (m <= 0 || n <= 0) error_and_exit ("provider_new_function", "m, n must be > 0.", __FILE__, __LINE__);
+	if (!func) error_and_exit ("provider_new_function", "func is empty.", __FILE__, __LINE__);
+	p = provider_alloc ();
+	if (p == NULL) error_and_exit ("provider_new_function", "failed to allocate object.", __FILE__, __LINE__);
+	p->type = PROVIDER_FUNCTION;
+	p->m = m;
+	p->n = n;
+	p->func = func;
+	p->data = data;
+	p->pool = xjpool_new (m, n, budget);
+	return p;
+}
+
+/*** free provider object. X of PROVIDER_MATRIX is not freed ***/
+void
+provider_free (provider *p)
+{
+	if (p) {
+		if (p->pool) xjpool_free (p->pool);
+		if (p->map) munmap (p->map, p->maplen);
+		if (p->fp) fclose (p->fp);
+		if (p->sx) free (p->sx);
+		if (p->xtx) free (p->xtx);
+		if (p->scale) free (p->scale);
+		free (p);
+	}
+	return;
+}
+
+/*** whether X is stored in memory as mm_real ***/
+bool
+provider_is_in_core (const provider *p)
+{
+	return (p->type == PROVIDER_MATRIX);
+}
+
+/*** start the background thread which reads ahead the following nahead columns
+ * of the accessed one, so that the disk reads of cyclic sweeps are overlapped
+ * with the updates. nahead is limited to half the number of the slots of the pool.
+ * Nothing is done if X is in memory or mapped (see provider_advise),
+ * the pool has too few slots, or the thread is already started ***/
+void
+provider_read_ahead (provider *p, const int nahead)
+{
+	int		na;
+	xjpool	*pool = p->pool;
+	if (provider_is_in_core (p) || p->type == PROVIDER_XMATFILE_MMAP) return;
+	na = (nahead < pool->nslots / 2) ? nahead : pool->nslots / 2;
+	if (pool->nahead > 0 || na <= 0) return;
+	pool->nahead = na;
+	if (pthread_create (&pool->ahead_thread, NULL, xjpool_read_ahead_thread, p) != 0) {
+		printf_warning ("provider_read_ahead", "failed to create thread, read-ahead is disabled.", __FILE__, __LINE__);
+		pool->nahead = 0;
+	}
+	return;
+}
+
+/*** advise the access pattern of the mapped container:
+ * sequential for cyclic sweeps, or normal (random) for stochastic ones.
+ * Nothing is done if the container is not mapped ***/
+void
+provider_advise (const provider *p, const bool sequential)
+{
+	if (p->type != PROVIDER_XMATFILE_MMAP) return;
+	madvise (p->map, p->maplen, (sequential) ? MADV_SEQUENTIAL : MADV_NORMAL);
+	return;
+}
+
+/*** advise that j-th column of X will be used soon, e.g. it is in the active set.
+ * Nothing is done if the container is not mapped ***/
+void
+provider_willneed (const provider *p, const int j)
+{
+	int		b;
+	size_t	page;
+	if (p->type != PROVIDER_XMATFILE_MMAP) return;
+	// madvise requires the address aligned to the page
+	page = (size_t) sysconf (_SC_PAGESIZE);
+	for (b = 0; b < xmatfile_nrowblocks (p); b++) {
+		size_t	start = xmatfile_record_offset (p, j, b);
+		size_t	end = start + mm_real_xmatfile_record_size (p->format, xmatfile_block_nrows (p, b));
+		start -= start % page;
+		madvise (p->map + start, end - start, MADV_WILLNEED);
+	}
+	return;
+}
+
+/*** num of columns loaded from the container or calculated, 0 if X is in memory or mapped ***/
+long
+provider_num_reads (const provider *p)
+{
+	return (p->pool && p->type != PROVIDER_XMATFILE_MMAP) ? p->pool->nreads : 0;
+}
+
+/*** num of accesses to the columns served from the pool ***/
+long
+provider_num_hits (const provider *p)
+{
+	return (p->pool) ? p->pool->nhits : 0;
+}
+
+/*** X(:,j) = alpha * X(:,j).
+ * For out-of-core X, the scale is applied when the column is loaded ***/
+void
+provider_scale_column (provider *p, const int j, const double alpha)
+{
+	int		s;
+	if (j < 0 || p->n <= j) error_and_exit ("provider_scale_column", "index out of range.", __FILE__, __LINE__);
+	if (provider_is_in_core (p)) {
+		mm_real_xj_scale (p->x, j, alpha);
+		return;
+	}
+	pthread_mutex_lock (&p->pool->lock);
+	if (p->scale == NULL) {
+		int		k;
+		double	*scale = (double *) malloc (p->n * sizeof (double));
+		if (scale == NULL) error_and_exit ("provider_scale_column", "cannot allocate memory.", __FILE__, __LINE__);
+		for (k = 0; k < p->n; k++) scale[k] = 1.;
+		// the array is completed and flushed before it is published,
+		// since provider_load of the other threads reads p->scale without the lock
+#pragma omp flush
+#pragma omp atomic write
+		p->scale = scale;
+	}
+	p->scale[j] *= alpha;
+	// resident column is scaled in place
+	if ((s = p->pool->slot[j]) >= 0 && !p->pool->loading[s])
+		dscal_ (&p->m, &alpha, p->pool->data + (size_t) s * p->m, &ione);
+	pthread_mutex_unlock (&p->pool->lock);
+	return;
+}
+
+/*******************************
+ *  operations on columns of X  *
+ *******************************/
+
+/*** return sum X(:,j) ***/
+double
+provider_xj_sum (const provider *p, const int j)
+{
+	int		i, k;
+	double	val = 0.;
+	double	*xj;
+	if (provider_is_in_core (p)) return mm_real_xj_sum (p->x, j);
+	xj = provider_acquire (p, j, &k);
+	for (i = 0; i < p->m; i++) val += xj[i];
+	provider_release (p, k, xj);
+	return val;
+}
+
+/*** return X(:,j)' * X(:,j) ***/
+double
+provider_xj_ssq (const provider *p, const int j)
+{
+	int		k;
+	double	val;
+	double	*xj;
+	if (provider_is_in_core (p)) return mm_real_xj_ssq (p->x, j);
+	xj = provider_acquire (p, j, &k);
+	val = ddot_ (&p->m, xj, &ione, xj, &ione);
+	provider_release (p, k, xj);
+	return val;
+}
+
+/*** return X(:,j)' * y ***/
+double
+provider_xj_trans_dot_y (const provider *p, const int j, const mm_dense *y)
+{
+	int		k;
+	double	val;
+	double	*xj;
+	if (provider_is_in_core (p)) return mm_real_xj_trans_dot_yk (p->x, j, y, 0);
+	if (j < 0 || p->n <= j) error_and_exit ("provider_xj_trans_dot_y", "index out of range.", __FILE__, __LINE__);
+	if (p->m != y->m) error_and_exit ("provider_xj_trans_dot_y", "dimensions of x and y do not match.", __FILE__, __LINE__);
+	xj = provider_acquire (p, j, &k);
+	val = ddot_ (&p->m, xj, &ione, y->data, &ione);
+	provider_release (p, k, xj);
+	return val;
+}
+
+/*** y = alpha * X(:,j) + y ***/
+void
+provider_axjpy (const double alpha, const provider *p, const int j, mm_dense *y)
+{
+	int		k;
+	double	*xj;
+	if (provider_is_in_core (p)) {
+		mm_real_axjpy (alpha, p->x, j, y);
+		return;
+	}
+	if (j < 0 || p->n <= j) error_and_exit ("provider_axjpy", "index out of range.", __FILE__, __LINE__);
+	if (p->m != y->m) error_and_exit ("provider_axjpy", "dimensions of x and y do not match.", __FILE__, __LINE__);
+	xj = provider_acquire (p, j, &k);
+	daxpy_ (&p->m, &alpha, xj, &ione, y->data, &ione);
+	provider_release (p, k, xj);
+	return;
+}
+
+/*** y = alpha * X(:,j) + y, atomic ***/
+void
+provider_axjpy_atomic (const double alpha, const provider *p, const int j, mm_dense *y)
+{
+	int		i, k;
+	double	*xj;
+	if (provider_is_in_core (p)) {
+		mm_real_axjpy_atomic (alpha, p->x, j, y);
+		return;
+	}
+	if (j < 0 || p->n <= j) error_and_exit ("provider_axjpy_atomic", "index out of range.", __FILE__, __LINE__);
+	if (p->m != y->m) error_and_exit ("provider_axjpy_atomic", "dimensions of x and y do not match.", __FILE__, __LINE__);
+	xj = provider_acquire (p, j, &k);
+	for (i = 0; i < p->m; i++) atomic_add (y->data + i, alpha * xj[i]);
+	provider_release (p, k, xj);
+	return;
+}
+
+/* advise that the tiles which hold the columns j0, ..., j0 + nc - 1 of the container will be read soon,
+ * so that OS reads them ahead while the current columns are processed */
+static void
+xmatfile_prefetch (const provider *p, const int j0, const int nc)
+{
+	int		j1;
+	size_t	start, len;
+	if (nc <= 0) return;
+	// the tiles are contiguous in the container for any division of the rows
+	j1 = ((j0 + nc - 1) / p->tile + 1) * p->tile;
+	if (j1 > p->n) j1 = p->n;
+	start = p->offset + (size_t) (j0 / p->tile) * p->tile * p->reclen;
+	len = p->offset + (size_t) j1 * p->reclen - start;
+	if (p->type == PROVIDER_XMATFILE_MMAP) {
+		// madvise requires the address aligned to the page
+		size_t	page = (size_t) sysconf (_SC_PAGESIZE);
+		len += start % page;
+		start -= start % page;
+		madvise (p->map + start, len, MADV_WILLNEED);
+	} else posix_fadvise (fileno (p->fp), (off_t) start, (off_t) len, POSIX_FADV_WILLNEED);
+	return;
+}
+
+/* load the rows of b-th row block of the columns j0, ..., j0 + nc - 1 of a tile of the container
+ * into block (mb x nc, column major, where mb is the num of rows of the row block)
+ * by one sequential read, and return the pointer to the columns in double.
+ * The columns stored in double in the mapped container are not copied, and raw is the buffer
+ * to read the encoded columns of other format (size nc * mm_real_xmatfile_record_size (format, rowblock)).
+ * The scale of the columns (see provider_scale_column) is not applied */
+static const double *
+xmatfile_load_rows (const provider *p, const int b, const int j0, const int nc, char *raw, double *block)
+{
+	int			k;
+	const char	*src;
+	int			mb = xmatfile_block_nrows (p, b);
+	size_t		rs = mm_real_xmatfile_record_size (p->format, mb);
+	size_t		len = (size_t) nc * rs;
+	size_t		offset = xmatfile_record_offset (p, j0, b);
+
+	if (p->type == PROVIDER_XMATFILE_MMAP) {
+		src = p->map + offset;
+		if (p->format == MM_REAL_XMAT_FLOAT64) return (const double *) src;
+	} else {
+		size_t	done = 0;
+		char	*dst = (p->format == MM_REAL_XMAT_FLOAT64) ? (char *) block : raw;
+		while (done < len) {
+			ssize_t	ret = pread (fileno (p->fp), dst + done, len - done, (off_t) (offset + done));
+			if (ret <= 0) error_and_exit ("xmatfile_load_rows", "failed to read columns of X.", __FILE__, __LINE__);
+			done += (size_t) ret;
+		}
+		if (p->format == MM_REAL_XMAT_FLOAT64) return block;
+		src = raw;
+	}
+	for (k = 0; k < nc; k++) mm_real_xmatfile_decode (p->format, mb, src + (size_t) k * rs, block + (size_t) k * mb);
+	return block;
+}
+
+/* load the rows of b-th row block of the columns j0, ..., j0 + nc - 1 of the container,
+ * which may span several tiles, into block (mb x nc) tile by tile (see xmatfile_load_rows) */
+static const double *
+xmatfile_load_xb (const provider *p, const int b, const int j0, const int nc, char *raw, double *block)
+{
+	int		k;
+	int		mb = xmatfile_block_nrows (p, b);
+
+	if (j0 / p->tile == (j0 + nc - 1) / p->tile) return xmatfile_load_rows (p, b, j0, nc, raw, block);
+	for (k = 0; k < nc; ) {
+		int				j = j0 + k;
+		// up to the end of the tile
+		int				len = (j / p->tile + 1) * p->tile - j;
+		double			*dst = block + (size_t) k * mb;
+		const double	*xt;
+		if (len > nc - k) len = nc - k;
+		xt = xmatfile_load_rows (p, b, j, len, raw, dst);
+		if (xt != dst) memcpy (dst, xt, (size_t) mb * len * sizeof (double));
+		k += len;
+	}
+	return block;
+}
+
+/* allocate the buffers to load the row blocks of nc columns of the container
+ * by xmatfile_load_rows or xmatfile_load_xb. raw is NULL if the columns are stored in double */
+static void
+xmatfile_buffers (const provider *p, const int nc, double **block, char **raw)
+{
+	*block = (double *) work_malloc ((size_t) p->rowblock * nc * sizeof (double));
+	*raw = NULL;
+	if (p->format != MM_REAL_XMAT_FLOAT64)
+		*raw = (char *) work_malloc ((size_t) nc * mm_real_xmatfile_record_size (p->format, p->rowblock));
+	if (*block == NULL || (p->format != MM_REAL_XMAT_FLOAT64 && *raw == NULL))
+		error_and_exit ("xmatfile_buffers", "cannot allocate memory.", __FILE__, __LINE__);
+	return;
+}
+
+/* return the buffers of the pool to load the row blocks of the block of nb columns
+ * and c of size nb. They are allocated only when a larger block than ever is given,
+ * so the operations on the blocks do not allocate in the cycles of the solver */
+static void
+xmatfile_xb_buffers (const provider *p, const int nb, double **block, char **raw, double **c)
+{
+	xjpool	*pool = p->pool;
+	if (pool->xbcols < nb) {
+		if (pool->xbblock) free (pool->xbblock);
+		if (pool->xbraw) free (pool->xbraw);
+		if (pool->xbc) free (pool->xbc);
+		xmatfile_buffers (p, nb, &pool->xbblock, &pool->xbraw);
+		pool->xbc = (double *) work_malloc (nb * sizeof (double));
+		if (pool->xbc == NULL) error_and_exit ("xmatfile_xb_buffers", "cannot allocate memory.", __FILE__, __LINE__);
+		pool->xbcols = nb;
+	}
+	*block = pool->xbblock;
+	*raw = pool->xbraw;
+	if (c) *c = pool->xbc;
+	return;
+}
+
+/* z = alpha * X * y + beta * z or z = alpha * X' * y + beta * z of X stored in the container.
+ * X is streamed by tiles of consecutive columns, and each row block of a tile is read
+ * by one sequential read and multiplied by dgemv, while the next tile of the thread is read ahead by OS.
+ * In X * y, only the columns from the first to the last nonzero y(j) of each tile are read,
+ * and the tiles of y(j) = 0 are skipped, so that X * beta of sparse beta reads few columns.
+ * The tiles are distributed to the threads, and X * y is summed up from the partial sums of the threads.
+ * The pool of column buffers is not used, so the streamed columns do not evict the resident ones */
+static void
+xmatfile_dot_y (const bool trans, const double alpha, const provider *p, const mm_dense *y,
+	const double beta, mm_dense *z)
+{
+	int			ntiles = (p->n + p->tile - 1) / p->tile;
+	int			nrb = xmatfile_nrowblocks (p);
+	int			nth = 1;
+	double		*zt;
+
+#ifdef _OPENMP
+	nth = omp_get_max_threads ();
+#endif
+	// partial sums of X * y of the threads
+	zt = (trans) ? NULL : (double *) work_calloc ((size_t) p->m * nth, sizeof (double));
+	if (!trans && zt == NULL) error_and_exit ("xmatfile_dot_y", "cannot allocate memory.", __FILE__, __LINE__);
+
+#pragma omp parallel num_threads(nth)
+	{
+		int		t, b, k;
+		int		tid = 0;
+		int		nthreads = 1;
+		double	*block;
+		char	*raw;
+		double	*c = (double *) work_malloc (p->tile * sizeof (double));
+
+#ifdef _OPENMP
+		tid = omp_get_thread_num ();
+		nthreads = omp_get_num_threads ();
+#endif
+		if (c == NULL) error_and_exit ("xmatfile_dot_y", "cannot allocate memory.", __FILE__, __LINE__);
+		xmatfile_buffers (p, p->tile, &block, &raw);
+
+#pragma omp for schedule(static, 1)
+		for (t = 0; t < ntiles; t++) {
+			int				j0 = t * p->tile;
+			int				nc = (p->n - j0 < p->tile) ? p->n - j0 : p->tile;
+			int				tn = t + nthreads;
+			const double	*xt;
+
+			// next tile of this thread
+			if (tn < ntiles) xmatfile_prefetch (p, tn * p->tile, 1);
+
+			if (trans) {
+				// c = X(:,j0:j0+nc-1)' * y, summed up over the row blocks
+				for (b = 0; b < nrb; b++) {
+					int		mb = xmatfile_block_nrows (p, b);
+					xt = xmatfile_load_rows (p, b, j0, nc, raw, block);
+					dgemv_ ("T", &mb, &nc, &done, xt, &mb, y->data + (size_t) b * p->rowblock, &ione,
+						(b == 0) ? &dzero : &done, c, &ione);
+				}
+				for (k = 0; k < nc; k++) {
+					int		j = j0 + k;
+					double	val = alpha * c[k];
+					if (p->scale) val *= p->scale[j];
+					z->data[j] = (fabs (beta) > DBL_EPSILON) ? beta * z->data[j] + val : val;
+				}
+			} else {
+				// zt += X(:,lo:hi) * y(lo:hi), where y(lo) and y(hi) are the first and the last nonzero in the tile
+				int		lo = j0;
+				int		hi = j0 + nc - 1;
+				int		len;
+				double	*ztt = zt + (size_t) tid * p->m;
+				while (lo <= hi && y->data[lo] == 0.) lo++;
+				while (hi >= lo && y->data[hi] == 0.) hi--;
+				if (lo > hi) continue;
+				len = hi - lo + 1;
+				for (k = 0; k < len; k++) {
+					c[k] = alpha * y->data[lo + k];
+					if (p->scale) c[k] *= p->scale[lo + k];
+				}
+				for (b = 0; b < nrb; b++) {
+					int		mb = xmatfile_block_nrows (p, b);
+					xt = xmatfile_load_rows (p, b, lo, len, raw, block);
+					dgemv_ ("N", &mb, &len, &done, xt, &mb, c, &ione, &done, ztt + (size_t) b * p->rowblock, &ione);
+				}
+			}
+		}
+		free (block);
+		free (c);
+		if (raw) free (raw);
+	}
+
+	if (!trans) {
+		int		i, k;
+		if (fabs (beta) > DBL_EPSILON) dscal_ (&p->m, &beta, z->data, &ione);
+		else mm_real_set_all (z, 0.);
+		for (k = 0; k < nth; k++) {
+			double	*ztk = zt + (size_t) k * p->m;
+			for (i = 0; i < p->m; i++) z->data[i] += ztk[i];
+		}
+		free (zt);
+	}
+	return;
+}
+
+/*** z = alpha * X * y + beta * z, or z = alpha * X' * y + beta * z if trans ***/
+void
+provider_dot_y (const bool trans, const double alpha, const provider *p, const mm_dense *y,
+	const double beta, mm_dense *z)
+{
+	int		j;
+	if (provider_is_in_core (p)) {
+		mm_real_x_dot_yk (trans, alpha, p->x, y, 0, beta, z);
+		return;
+	}
+	if ((trans && p->m != y->m) || (!trans && p->n != y->m))
+		error_and_exit ("provider_dot_y", "dimensions of x and y do not match.", __FILE__, __LINE__);
+	if ((trans && p->n != z->m) || (!trans && p->m != z->m))
+		error_and_exit ("provider_dot_y", "dimensions of x and z do not match.", __FILE__, __LINE__);
+
+	if (p->type == PROVIDER_XMATFILE || p->type == PROVIDER_XMATFILE_MMAP) {
+		xmatfile_dot_y (trans, alpha, p, y, beta, z);
+		return;
+	}
+
+	if (trans) {
+		// each column is read once, and z(j) is owned by the thread which reads X(:,j)
+#pragma omp parallel for
+		for (j = 0; j < p->n; j++) {
+			double	val = alpha * provider_xj_trans_dot_y (p, j, y);
+			z->data[j] = (fabs (beta) > DBL_EPSILON) ? beta * z->data[j] + val : val;
+		}
+	} else {
+		if (fabs (beta) > DBL_EPSILON) dscal_ (&p->m, &beta, z->data, &ione);
+		else mm_real_set_all (z, 0.);
+		for (j = 0; j < p->n; j++) if (y->data[j] != 0.) provider_axjpy (alpha * y->data[j], p, j, z);
+	}
+	return;
+}
+
+/*****************************************
+ *  operations on blocks of columns of X  *
+ *****************************************/
+
+/*** whether the operations on the blocks of consecutive columns of X (provider_xb_*) are available,
+ * i.e. X is dense general in memory, or stored in the container ***/
+bool
+provider_has_blocks (const provider *p)
+{
+	if (p->type == PROVIDER_MATRIX) return (mm_real_is_dense (p->x) && !mm_real_is_symmetric (p->x));
+	return (p->type == PROVIDER_XMATFILE || p->type == PROVIDER_XMATFILE_MMAP);
+}
+
+/* check the block B = [j0, j0 + nb) of X for the function func */
+static void
+provider_check_block (const provider *p, const int j0, const int nb, const char *func)
+{
+	if (!provider_has_blocks (p)) error_and_exit (func, "X must be dense general or stored in xmat file.", __FILE__, __LINE__);
+	if (j0 < 0 || nb <= 0 || p->n < j0 + nb) error_and_exit (func, "index out of range.", __FILE__, __LINE__);
+	return;
+}
+
+/*** z = X_B' * y of the block B = [j0, j0 + nb) of consecutive columns of X, where z is of size nb.
+ * X_B in the container is read by the row blocks, so that only a row block of X_B
+ * is in memory at once, and the tiles of the next block are read ahead by OS.
+ * The row block is loaded into the work space of the pool, so this is not called concurrently ***/
+void
+provider_xb_trans_dot_y (const provider *p, const int j0, const int nb, const mm_dense *y, double *z)
+{
+	int		b, k;
+	double	*block;
+	char	*raw;
+
+	provider_check_block (p, j0, nb, "provider_xb_trans_dot_y");
+	if (p->m != y->m) error_and_exit ("provider_xb_trans_dot_y", "dimensions of x and y do not match.", __FILE__, __LINE__);
+
+	if (provider_is_in_core (p)) {
+		dgemv_ ("T", &p->m, &nb, &done, p->x->data + (size_t) j0 * p->m, &p->m, y->data, &ione, &dzero, z, &ione);
+		return;
+	}
+
+	if (j0 + nb < p->n) xmatfile_prefetch (p, j0 + nb, (p->n - j0 - nb < nb) ? p->n - j0 - nb : nb);
+	xmatfile_xb_buffers (p, nb, &block, &raw, NULL);
+	for (b = 0; b < xmatfile_nrowblocks (p); b++) {
+		int				mb = xmatfile_block_nrows (p, b);
+		const double	*xt = xmatfile_load_xb (p, b, j0, nb, raw, block);
+		dgemv_ ("T", &mb, &nb, &done, xt, &mb, y->data + (size_t) b * p->rowblock, &ione,
+			(b == 0) ? &dzero : &done, z, &ione);
+	}
+	if (p->scale) for (k = 0; k < nb; k++) z[k] *= p->scale[j0 + k];
+	return;
+}
+
+/*** y = X_B * eta + y of the block B = [j0, j0 + nb) of consecutive columns of X,
+ * where eta is of size nb. X_B in the container is read by the row blocks,
+ * and each row block of y is updated by its own row block of X_B.
+ * The work space of the pool is used as provider_xb_trans_dot_y ***/
+void
+provider_xb_dot_etapy (const provider *p, const int j0, const int nb, const double *eta, mm_dense *y)
+{
+	int		b, k;
+	double	*block;
+	char	*raw;
+	double	*c;
+
+	provider_check_block (p, j0, nb, "provider_xb_dot_etapy");
+	if (p->m != y->m) error_and_exit ("provider_xb_dot_etapy", "dimensions of x and y do not match.", __FILE__, __LINE__);
+
+	if (provider_is_in_core (p)) {
+		dgemv_ ("N", &p->m, &nb, &done, p->x->data + (size_t) j0 * p->m, &p->m, eta, &ione, &done, y->data, &ione);
+		return;
+	}
+
+	xmatfile_xb_buffers (p, nb, &block, &raw, &c);
+	for (k = 0; k < nb; k++) c[k] = (p->scale) ? eta[k] * p->scale[j0 + k] : eta[k];
+	for (b = 0; b < xmatfile_nrowblocks (p); b++) {
+		int				mb = xmatfile_block_nrows (p, b);
+		const double	*xt = xmatfile_load_xb (p, b, j0, nb, raw, block);
+		dgemv_ ("N", &mb, &nb, &done, xt, &mb, c, &ione, &done, y->data + (size_t) b * p->rowblock, &ione);
+	}
+	return;
+}
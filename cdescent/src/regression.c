@@ -13,40 +13,134 @@
 
 #include "private/private.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 /* cyclic.c */
 extern bool			cdescent_do_update_once_cycle_cyclic (cdescent *cd);
 /* stochastic.c */
 extern bool			cdescent_do_update_once_cycle_stochastic (cdescent *cd);
+/* accelerated.c */
+extern bool			cdescent_do_update_once_cycle_accelerated (cdescent *cd);
+/* greedy.c */
+extern bool			cdescent_do_update_once_cycle_greedy (cdescent *cd);
+/* block.c */
+extern bool			cdescent_do_update_once_cycle_block (cdescent *cd);
+/* svrg.c */
+extern bool			cdescent_do_update_once_cycle_svrg (cdescent *cd);
+/* sweep.c */
+extern void			cdescent_select_sweep (cdescent *cd);
+/* anderson.c */
+extern void			cdescent_anderson_reset (cdescent *cd);
+extern void			cdescent_anderson_update (cdescent *cd);
 
 typedef bool (*update_one_cycle) (cdescent *cd);
 
-/*** do cyclic coordinate descent optimization for fixed lambda1
- * repeat coordinate descent algorithm until solution is converged ***/
-bool
-cdescent_do_update_one_cycle (cdescent *cd)
+/* whether cd needs a team of threads */
+static bool
+use_worker_team (const cdescent *cd)
 {
-	int					ccd_iter = 0;
-	bool				converged = false;
+	if (cd->rule == CDESCENT_SELECTION_RULE_ACCELERATED || cd->rule == CDESCENT_SELECTION_RULE_GREEDY
+		|| cd->rule == CDESCENT_SELECTION_RULE_BLOCK || cd->rule == CDESCENT_SELECTION_RULE_SVRG) return false;
+	return (cd->parallel || cd->row_parallel);
+}
 
-	update_one_cycle	update_func;
+/* whether the caller is a member of an active team of threads */
+static bool
+in_worker_team (void)
+{
+#ifdef _OPENMP
+	return omp_in_parallel ();
+#else
+	return false;
+#endif
+}
 
-	update_func = (cd->rule == CDESCENT_SELECTION_RULE_STOCHASTIC) ?
-			cdescent_do_update_once_cycle_stochastic : cdescent_do_update_once_cycle_cyclic;
+/* repeat update_func until solution is converged.
+ * This function is executed by all threads of the worker team,
+ * update_func returns the same value on every thread */
+static bool
+do_update_one_cycle (cdescent *cd, update_one_cycle update_func)
+{
+	int		ccd_iter = 0;
+	bool	converged = false;
 
+	// specialized sweep for current lambda
+#pragma omp single
+	cdescent_select_sweep (cd);
 
-	if (!cd) error_and_exit ("cdescent_do_cyclic_update", "cdescent *cd is empty.", __FILE__, __LINE__);
+	// iterates of previous lambda are not used for extrapolation
+	if (cd->aa) {
+#pragma omp single
+		cdescent_anderson_reset (cd);
+	}
 
 	while (!converged) {
 
 		converged = update_func (cd);
 
+		// Anderson extrapolation of the iterates of sweeps
+		if (cd->aa && !converged) {
+#pragma omp single
+			cdescent_anderson_update (cd);
+		}
+
 		if (++ccd_iter >= cd->maxiter) {
+#pragma omp single nowait
 			printf_warning ("cdescent_do_cyclic_update", "reaching max number of iterations.", __FILE__, __LINE__);
 			break;
 		}
 
 	}
+#pragma omp single
 	cd->total_iter += ccd_iter;
+
+	return converged;
+}
+
+/*** do cyclic coordinate descent optimization for fixed lambda1
+ * repeat coordinate descent algorithm until solution is converged.
+ * If this is called inside the worker team of cdescent_do_pathwise_optimization,
+ * the team is reused, otherwise new team is created for this call ***/
+bool
+cdescent_do_update_one_cycle (cdescent *cd)
+{
+	bool				converged = false;
+
+	update_one_cycle	update_func;
+
+	if (!cd) error_and_exit ("cdescent_do_cyclic_update", "cdescent *cd is empty.", __FILE__, __LINE__);
+
+	switch (cd->rule) {
+		case CDESCENT_SELECTION_RULE_STOCHASTIC:
+			update_func = cdescent_do_update_once_cycle_stochastic;
+			break;
+		case CDESCENT_SELECTION_RULE_ACCELERATED:
+			update_func = cdescent_do_update_once_cycle_accelerated;
+			break;
+		case CDESCENT_SELECTION_RULE_GREEDY:
+			update_func = cdescent_do_update_once_cycle_greedy;
+			break;
+		case CDESCENT_SELECTION_RULE_BLOCK:
+			update_func = cdescent_do_update_once_cycle_block;
+			break;
+		case CDESCENT_SELECTION_RULE_SVRG:
+			update_func = cdescent_do_update_once_cycle_svrg;
+			break;
+		default:
+			update_func = cdescent_do_update_once_cycle_cyclic;
+			break;
+	}
+
+	if (in_worker_team ()) return do_update_one_cycle (cd, update_func);
+
+#pragma omp parallel if (use_worker_team (cd)) proc_bind(spread)
+	{
+		bool	conv = do_update_one_cycle (cd, update_func);
+#pragma omp master
+		converged = conv;
+	}
 	return converged;
 }
 
@@ -71,14 +165,40 @@ static double
 calc_rss (const cdescent *cd)
 {
 	double	rss;
-	mm_dense	*r = mm_real_copy (cd->lreg->y);
+	mm_dense	*r = cd->work->r;
+	mm_real_memcpy (r, cd->lreg->y);	// r = y
 	mm_real_axjpy (-1., cd->mu, 0, r);	// r = y - mu
 	if (cd->use_intercept) mm_real_xj_add_const (r, 0, - cd->b0);	// r = y - mu - b0
 	rss = mm_real_xj_ssq (r, 0);
-	mm_real_free (r);
 	return rss;
 }
 
+/* value of objective function at beta
+ * F = || y - mu - b0 ||^2 / 2 + lambda2 * || nu ||^2 / 2 + lambda1 * sum_j w(j) * | beta(j) | */
+double
+cdescent_objective (const cdescent *cd)
+{
+	int		i, j;
+	double	b0 = (cd->use_intercept) ? cd->b0 : 0.;
+	double	rss = 0.;
+	double	pen1 = 0.;
+	double	obj;
+
+	for (i = 0; i < *cd->m; i++) {
+		double	ri = cd->lreg->y->data[i] - cd->mu->data[i] - b0;
+		rss += ri * ri;
+	}
+	obj = 0.5 * rss;
+	if (!cd->is_regtype_lasso) obj += 0.5 * cd->lambda2 * mm_real_xj_ssq (cd->nu, 0);
+
+	for (j = 0; j < *cd->n; j++) {
+		double	abs_betaj = fabs (cd->beta->data[j]);
+		pen1 += (cd->w) ? cd->w->data[j] * abs_betaj : abs_betaj;
+	}
+	obj += cd->lambda1 * pen1;
+	return obj;
+}
+
 /* reset cdescent object */
 static void
 cdescent_reset (cdescent *cd)
@@ -90,6 +210,8 @@ cdescent_reset (cdescent *cd)
 	if (!cd->is_regtype_lasso) mm_real_set_all (cd->nu, 0.);
 	cd->total_iter = 0;
 	cd->was_modified = false;
+	if (cd->acc) cd->acc->restart = true;
+	if (cd->svrg) cd->svrg->lambda = 0.;
 	return;
 }
 
@@ -106,9 +228,12 @@ cdescent_do_pathwise_optimization (cdescent *cd)
 	int			iter;
 	double		logt;
 	bool		stop_flag = false;
+	bool		finished;
 
 	bool		converged;
 
+	long		nalloc;
+
 	FILE		*fp_path = NULL;
 	FILE		*fp_info = NULL;
 
@@ -141,35 +266,74 @@ cdescent_do_pathwise_optimization (cdescent *cd)
 	if (cd->verbose) fprintf (stderr, "starting pathwise optimization.\n");
 
 	iter = 0;
-	while (1) {
-
-		cdescent_set_log10_lambda (cd, logt);
-		if (cd->verbose) fprintf (stderr, "%d-th iteration lambda1 = %.4e, lamba2 = %.4e ", iter, cd->lambda1, cd->lambda2);
-
-		if (!(converged = cdescent_do_update_one_cycle (cd))) break;
-
-		// output solution path
-		if (fp_path) {
-			if (cd->output_rescaled) fprintf_solutionpath (fp_path, cd);
-			else fprintf_weighted_solutionpath (fp_path, cd);
-		}
-
-		// output regression info
-		if (fp_info) {
-			// |beta|  ||beta||^2 RSS lambda1 lambda2
-			fprintf (fp_info, "%.16e\t%.16e\t%.16e\t%.16e\t%.16e\n", cd->nrm1, mm_real_xj_ssq (cd->beta, 0), calc_rss (cd), cd->lambda1, cd->lambda2);
-			fflush (fp_info);
+	converged = false;
+	finished = false;
+
+	// number of mm_real objects and work spaces allocated so far, to report allocations in each lambda
+	nalloc = cdescent_num_allocated ();
+
+	// columns of X not in memory are visited in order except by the stochastic rule
+	provider_advise (cd->lreg->prov, cd->rule != CDESCENT_SELECTION_RULE_STOCHASTIC);
+
+	/* one long-lived team of threads is used for the whole path,
+	 * the serial parts are executed by a single thread of the team */
+#pragma omp parallel if (use_worker_team (cd)) proc_bind(spread)
+	{
+		while (1) {
+			bool	conv;
+
+#pragma omp single
+			{
+				cdescent_set_log10_lambda (cd, logt);
+				if (cd->verbose) fprintf (stderr, "%d-th iteration lambda1 = %.4e, lamba2 = %.4e ", iter, cd->lambda1, cd->lambda2);
+			}
+
+			conv = cdescent_do_update_one_cycle (cd);
+
+#pragma omp single
+			{
+				converged = conv;
+				if (converged) {
+					// L1 norm of beta is only reported, so it is not updated in the cycles
+					cd->nrm1 = mm_real_xj_asum (cd->beta, 0);
+
+					// active columns of X are used from the start of the next lambda
+					if (!provider_is_in_core (cd->lreg->prov)) {
+						int		j;
+						for (j = 0; j < *cd->n; j++) if (cd->beta->data[j] != 0.) provider_willneed (cd->lreg->prov, j);
+					}
+
+					// output solution path
+					if (fp_path) {
+						if (cd->output_rescaled) fprintf_solutionpath (fp_path, cd);
+						else fprintf_weighted_solutionpath (fp_path, cd);
+					}
+
+					// output regression info
+					if (fp_info) {
+						// |beta|  ||beta||^2 RSS lambda1 lambda2
+						fprintf (fp_info, "%.16e\t%.16e\t%.16e\t%.16e\t%.16e\n", cd->nrm1, mm_real_xj_ssq (cd->beta, 0), calc_rss (cd), cd->lambda1, cd->lambda2);
+						fflush (fp_info);
+					}
+
+					if (cd->verbose) {
+						long	num = cdescent_num_allocated ();
+						fprintf (stderr, "done. (%ld allocated)\n", num - nalloc);
+						nalloc = num;
+					}
+
+					if (stop_flag) finished = true;
+					else {
+						/* if logt - dlog10_lambda1 < log10_lambda1, logt = log10_lambda1 and stop_flag is set to true
+						 * else logt -= dlog10_lambda1 */
+						stop_flag = set_logt (cd->log10_lambda_lower, logt - cd->log10_dlambda, &logt);
+						iter++;
+					}
+				}
+			}
+
+			if (!conv || finished) break;
 		}
-
-		if (cd->verbose) fprintf (stderr, "done.\n");
-
-		if (stop_flag) break;
-
-		/* if logt - dlog10_lambda1 < log10_lambda1, logt = log10_lambda1 and stop_flag is set to true
-		 * else logt -= dlog10_lambda1 */
-		stop_flag = set_logt (cd->log10_lambda_lower, logt - cd->log10_dlambda, &logt);
-
-		iter++;
 	}
 
 	if (fp_path) fclose (fp_path);
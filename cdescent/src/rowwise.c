@@ -0,0 +1,86 @@
+/*
+ * rowwise.c
+ *
+ *  Created on: 2026/10/18
+ *      Author: utsugi
+ */
+
+#include <stdlib.h>
+#include <cdescent.h>
+#include <mmreal.h>
+
+#include "private/private.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/* update.c */
+extern double	cdescent_update_beta_nu (cdescent *cd, int j, const double xjmu, double *amax_eta);
+
+/* stride of the array of partial sums, so as each thread writes on its own cache line */
+#define PARTIAL_STRIDE	8
+
+/*** progress coordinate descent update for one full cycle in row-partitioned parallel.
+ * Each thread of the team owns a contiguous row slice of X(:,j) and mu,
+ * computes the partial sum of X(:,j)' * mu on it, and after the partial sums are
+ * reduced in thread order, applies mu += eta(j) * X(:,j) on its own slice.
+ * So the updates are performed in exactly the same order as the serial cyclic update,
+ * and the result does not depend on the scheduling of the threads.
+ * If index != NULL, the coordinates are updated in order of index[0], index[1], ...
+ * This function is executed by all threads of the worker team
+ * (see cdescent_do_update_one_cycle) ***/
+void
+cdescent_update_rowwise (cdescent *cd, const int *index, double *amax_eta)
+{
+	int			k;
+	int			n = *cd->n;
+	int			m = *cd->m;
+	double		*xdata = cd->lreg->x->data;
+	double		*mu = cd->mu->data;
+
+	int			tid = 0;
+	int			nth = 1;
+	int			i0, len;
+
+#ifdef _OPENMP
+	tid = omp_get_thread_num ();
+	nth = omp_get_num_threads ();
+#endif
+
+	// array of partial sums is kept in cd and reused
+#pragma omp single
+	if (cd->npartial < nth) {
+		if (cd->partial) free (cd->partial);
+		cd->partial = (double *) work_malloc (nth * PARTIAL_STRIDE * sizeof (double));
+		if (cd->partial == NULL) error_and_exit ("cdescent_update_rowwise", "cannot allocate memory.", __FILE__, __LINE__);
+		cd->npartial = nth;
+	}
+
+	// row slice [i0, i0 + len) owned by this thread,
+	// this is same as the slice first touched by mm_real_first_touch (x, true)
+	static_partition (m, nth, tid, &i0, &len);
+
+	for (k = 0; k < n; k++) {
+		int		j = (index) ? index[k] : k;
+		double	*xj = xdata + (size_t) j * m;
+
+		// partial sum of X(:,j)' * mu
+		cd->partial[tid * PARTIAL_STRIDE] = (len > 0) ? ddot_ (&len, xj + i0, &ione, mu + i0, &ione) : 0.;
+#pragma omp barrier
+
+#pragma omp single
+		{
+			int		l;
+			double	xjmu = 0.;
+			for (l = 0; l < nth; l++) xjmu += cd->partial[l * PARTIAL_STRIDE];
+			// update beta(j) and nu, eta(j) is shared by the team
+			cd->etaj = cdescent_update_beta_nu (cd, j, xjmu, amax_eta);
+		}
+
+		// mu(i0:i0+len) += eta(j) * X(i0:i0+len,j)
+		if (cd->etaj != 0. && len > 0) daxpy_ (&len, &cd->etaj, xj + i0, &ione, mu + i0, &ione);
+	}
+
+	return;
+}
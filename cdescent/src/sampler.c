@@ -0,0 +1,249 @@
+/*
+ * sampler.c
+ *
+ *  Created on: 2026/10/18
+ *      Author: utsugi
+ */
+
+#include <stdlib.h>
+#include <cdescent.h>
+
+#include "private/private.h"
+#include "private/random.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/* stepsize.c */
+extern double	cdescent_scale2 (const cdescent *cd, const int j);
+
+/* allocate sampler object */
+static sampler *
+sampler_alloc (void)
+{
+	sampler	*s = (sampler *) malloc (sizeof (sampler));
+	if (s == NULL) return NULL;
+
+	s->seed = 1;
+	s->nrng = 0;
+	s->rng = NULL;
+
+	s->n = 0;
+	s->index = NULL;
+	s->nsel = 0;
+
+	s->importance = false;
+	s->lambda2 = -1.;
+	s->prob = NULL;
+	s->alias = NULL;
+	s->stack = NULL;
+	s->drawn = NULL;
+
+	return s;
+}
+
+/*** create new sampler object of n = *cd->n coordinates ***/
+sampler *
+sampler_new (const cdescent *cd, const unsigned int seed)
+{
+	int		j;
+	sampler	*s = sampler_alloc ();
+	if (s == NULL) error_and_exit ("sampler_new", "failed to allocate object.", __FILE__, __LINE__);
+
+	s->seed = seed;
+	s->n = *cd->n;
+	s->index = (int *) malloc (s->n * sizeof (int));
+	if (s->index == NULL) error_and_exit ("sampler_new", "cannot allocate memory.", __FILE__, __LINE__);
+	for (j = 0; j < s->n; j++) s->index[j] = j;
+
+	// generator of the first thread, the others are created on demand
+	s->rng = (xoshiro256 *) malloc (sizeof (xoshiro256));
+	if (s->rng == NULL) error_and_exit ("sampler_new", "cannot allocate memory.", __FILE__, __LINE__);
+	xoshiro256_init (s->rng, (uint64_t) s->seed);
+	s->nrng = 1;
+
+	return s;
+}
+
+/*** free sampler object ***/
+void
+sampler_free (sampler *s)
+{
+	if (s) {
+		if (s->rng) free (s->rng);
+		if (s->index) free (s->index);
+		if (s->prob) free (s->prob);
+		if (s->alias) free (s->alias);
+		if (s->stack) free (s->stack);
+		if (s->drawn) free (s->drawn);
+		free (s);
+	}
+	return;
+}
+
+/* make generators for nth threads, where the generator of k-th thread
+ * is seeded by seed + k, splitmix64 in xoshiro256_init decorrelates them */
+static void
+sampler_set_num_threads (sampler *s, const int nth)
+{
+	int		k;
+	if (s->nrng >= nth) return;
+	s->rng = (xoshiro256 *) work_realloc (s->rng, nth * sizeof (xoshiro256));
+	if (s->rng == NULL) error_and_exit ("sampler_set_num_threads", "cannot allocate memory.", __FILE__, __LINE__);
+	for (k = s->nrng; k < nth; k++) xoshiro256_init (s->rng + k, (uint64_t) s->seed + (uint64_t) k);
+	s->nrng = nth;
+	return;
+}
+
+/* build alias table of the probability p(j) = L(j) / sum(L),
+ * L(j) = X(:,j)' * X(:,j) + lambda2 * D(:,j)' * D(:,j), by Vose's method */
+static void
+sampler_build_alias_table (sampler *s, const cdescent *cd)
+{
+	int		j;
+	int		n = s->n;
+	int		nsmall = 0;
+	int		nlarge = 0;
+	int		*small;
+	int		*large;
+	double	sum = 0.;
+
+	// allocated at the first build, and reused when lambda2 is changed
+	if (s->prob == NULL) s->prob = (double *) work_malloc (n * sizeof (double));
+	if (s->alias == NULL) s->alias = (int *) work_malloc (n * sizeof (int));
+	if (s->stack == NULL) s->stack = (int *) work_malloc (2 * n * sizeof (int));
+	if (s->prob == NULL || s->alias == NULL || s->stack == NULL)
+		error_and_exit ("sampler_build_alias_table", "cannot allocate memory.", __FILE__, __LINE__);
+	small = s->stack;
+	large = s->stack + n;
+
+	for (j = 0; j < n; j++) {
+		s->prob[j] = cdescent_scale2 (cd, j);
+		sum += s->prob[j];
+	}
+	// scale so as the mean is 1
+	for (j = 0; j < n; j++) {
+		s->prob[j] *= (double) n / sum;
+		s->alias[j] = j;
+		if (s->prob[j] < 1.) small[nsmall++] = j;
+		else large[nlarge++] = j;
+	}
+	while (nsmall > 0 && nlarge > 0) {
+		int		l = small[--nsmall];
+		int		g = large[--nlarge];
+		s->alias[l] = g;
+		s->prob[g] -= 1. - s->prob[l];
+		if (s->prob[g] < 1.) small[nsmall++] = g;
+		else large[nlarge++] = g;
+	}
+	// remainders are 1 except for rounding error
+	while (nlarge > 0) s->prob[large[--nlarge]] = 1.;
+	while (nsmall > 0) s->prob[small[--nsmall]] = 1.;
+
+	s->lambda2 = cd->lambda2;
+	return;
+}
+
+/* draw one coordinate from the alias table */
+static int
+sampler_draw (const sampler *s, xoshiro256 *rng)
+{
+	int		j = xoshiro256_int (rng, s->n);
+	return (xoshiro256_double (rng) < s->prob[j]) ? j : s->alias[j];
+}
+
+/* shuffle s->index in place by Fisher-Yates algorithm.
+ * The buffer is not re-initialized, a permutation of a permutation is still uniform */
+static void
+sampler_shuffle (sampler *s, xoshiro256 *rng)
+{
+	int		i;
+	int		*index = s->index;
+	for (i = s->n - 1; i > 0; i--) {
+		int		j = xoshiro256_int (rng, i + 1);
+		int		tmp = index[i];
+		index[i] = index[j];
+		index[j] = tmp;
+	}
+	return;
+}
+
+/*** return uniform random permutation of 0, ..., n - 1,
+ * which is stored in the buffer of cd->sampler and valid until next call.
+ * This is executed by a single thread ***/
+int *
+cdescent_random_permutation (cdescent *cd)
+{
+	sampler_shuffle (cd->sampler, cd->sampler->rng);
+	return cd->sampler->index;
+}
+
+/* remove the repeated coordinates from the n draws in s->index keeping the order of the first draws,
+ * and return the num of the remaining coordinates. This is executed by a single thread */
+static int
+sampler_remove_repeats (sampler *s)
+{
+	int		j, k;
+	int		nsel = 0;
+	if (s->drawn == NULL) {
+		s->drawn = (bool *) work_malloc (s->n * sizeof (bool));
+		if (s->drawn == NULL) error_and_exit ("sampler_remove_repeats", "cannot allocate memory.", __FILE__, __LINE__);
+	}
+	for (j = 0; j < s->n; j++) s->drawn[j] = false;
+	for (k = 0; k < s->n; k++) {
+		j = s->index[k];
+		if (s->drawn[j]) continue;
+		s->drawn[j] = true;
+		s->index[nsel++] = j;
+	}
+	return nsel;
+}
+
+/*** return the coordinates selected for a sweep of the stochastic rule and set their num to *nsel:
+ * uniform random permutation, or if cd->sampler->importance,
+ * n independent draws in proportion to the curvature of the coordinates,
+ * where each thread draws its share by its own generator.
+ * The draws may select a coordinate more than once, which must not be updated by
+ * two threads at once, so the repeats are removed if the coordinates are updated concurrently
+ * (cd->parallel without cd->row_parallel).
+ * This is executed by all threads of the worker team, and the returned buffer
+ * is shared by the team ***/
+int *
+cdescent_sample_coordinates (cdescent *cd, int *nsel)
+{
+	sampler	*s = cd->sampler;
+	int		tid = 0;
+	int		nth = 1;
+
+#ifdef _OPENMP
+	tid = omp_get_thread_num ();
+	nth = omp_get_num_threads ();
+#endif
+
+#pragma omp single
+	{
+		sampler_set_num_threads (s, nth);
+		// curvature depends on lambda2
+		if (s->importance && s->lambda2 != cd->lambda2) sampler_build_alias_table (s, cd);
+	}
+
+	if (s->importance) {
+		int		k;
+		xoshiro256	*rng = s->rng + tid;
+#pragma omp for schedule(static)
+		for (k = 0; k < s->n; k++) s->index[k] = sampler_draw (s, rng);
+#pragma omp single
+		s->nsel = (cd->parallel && !cd->row_parallel) ? sampler_remove_repeats (s) : s->n;
+	} else {
+		// generator of the first thread is used, so as the sequence does not depend on the scheduling
+#pragma omp single
+		{
+			sampler_shuffle (s, s->rng);
+			s->nsel = s->n;
+		}
+	}
+
+	*nsel = s->nsel;
+	return s->index;
+}
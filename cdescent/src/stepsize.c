@@ -27,12 +27,12 @@ soft_threshold (const double z, const double gamma)
  * z = d L / d beta_j
  *   = c(j) - X(:,j)' * mu - X(:,j)' * b - lambda2 * D(:,j)' * D * beta
  *     + scale2 * beta_j,
- * however, the last term, scale2 * beta_j is omitted */
-static double
-cdescent_gradient (const cdescent *cd, const int j)
+ * however, the last term, scale2 * beta_j is omitted.
+ * xjmu = X(:,j)' * mu and djnu = D(:,j)' * nu are given by the caller */
+double
+cdescent_gradient_at (const cdescent *cd, const int j, const double xjmu, const double djnu)
 {
 	double	cj = cd->lreg->c->data[j];	// c = X' * y
-	double	xjmu = mm_real_xj_trans_dot_yk (cd->lreg->x, j, cd->mu, 0);	// X(:,j)' * mu
 
 	//	z = c(j) - X(:,j)' * mu
 	double	z = cj - xjmu;
@@ -43,14 +43,22 @@ cdescent_gradient (const cdescent *cd, const int j)
 	}
 
 	// not lasso, z -= lambda2 * D(:,j)' * nu (nu = D * beta)
-	if (!cd->is_regtype_lasso)
-		z -= cd->lambda2 * mm_real_xj_trans_dot_yk (cd->lreg->d, j, cd->nu, 0);
+	if (!cd->is_regtype_lasso) z -= cd->lambda2 * djnu;
 
 	return z;
 }
 
-/* return X(:,j)' * X(:,j) + D(:,j)' * D(:,j) * lambda2 */
+/* same as above, but D(:,j)' * nu is calculated for current nu */
 static double
+cdescent_gradient (const cdescent *cd, const int j, const double xjmu)
+{
+	double	djnu = 0.;
+	if (!cd->is_regtype_lasso) djnu = penalty_dj_trans_dot_y (cd->lreg->pen, j, cd->nu);
+	return cdescent_gradient_at (cd, j, xjmu, djnu);
+}
+
+/* return X(:,j)' * X(:,j) + D(:,j)' * D(:,j) * lambda2 */
+double
 cdescent_scale2 (const cdescent *cd, const int j)
 {
 	double	scale2 = (cd->lreg->xnormalized) ? 1. : cd->lreg->xtx[j];
@@ -58,14 +66,55 @@ cdescent_scale2 (const cdescent *cd, const int j)
 	return scale2;
 }
 
+/* return eta(j) = S(z / scale2 + beta(j), w(j) * lambda1 / scale2) - beta(j),
+ * where z is the gradient and scale2 is the curvature of the coordinate */
+static double
+prox_step (const cdescent *cd, const int j, const double z, const double scale2)
+{
+	double	gamma = cd->lambda1 / scale2;
+	if (cd->w) gamma *= cd->w->data[j];
+	return soft_threshold (z / scale2 + cd->beta->data[j], gamma) - cd->beta->data[j];
+}
+
+/*** return step-size for updating beta, where xjmu = X(:,j)' * mu is already known ***/
+double
+cdescent_beta_stepsize_xjmu (const cdescent *cd, const int j, const double xjmu)
+{
+	return prox_step (cd, j, cdescent_gradient (cd, j, xjmu), cdescent_scale2 (cd, j));
+}
+
+/*** return step-size for updating beta, where xjmu = X(:,j)' * mu
+ * and djnu = D(:,j)' * nu are already known ***/
+double
+cdescent_beta_stepsize_at (const cdescent *cd, const int j, const double xjmu, const double djnu)
+{
+	return prox_step (cd, j, cdescent_gradient_at (cd, j, xjmu, djnu), cdescent_scale2 (cd, j));
+}
+
 /*** return step-size for updating beta ***/
 double
 cdescent_beta_stepsize (const cdescent *cd, const int j)
 {
-	double	scale2 = cdescent_scale2 (cd, j);
-	double	z = cdescent_gradient (cd, j) / scale2;
-	double	gamma = cd->lambda1 / scale2;
-	if (cd->w) gamma *= cd->w->data[j];
-	/* eta(j) = S(z / scale2 + beta(j), w(j) * lambda1 / scale2) - beta(j) */
-	return soft_threshold (z + cd->beta->data[j], gamma) - cd->beta->data[j];
+	double	xjmu = provider_xj_trans_dot_y (cd->lreg->prov, j, cd->mu);	// X(:,j)' * mu
+	return cdescent_beta_stepsize_xjmu (cd, j, xjmu);
+}
+
+/*** return step-size for updating z(j) of the accelerated coordinate descent (see accelerated.c),
+ * where cd->beta holds the sequence z, xjy = X(:,j)' * X * y and djy = D(:,j)' * D * y
+ * are given at the extrapolated point y, and the curvature of the coordinate is
+ * inflated by ntheta = n * theta ***/
+double
+cdescent_z_stepsize (const cdescent *cd, const int j, const double xjy, const double djy, const double ntheta)
+{
+	return prox_step (cd, j, cdescent_gradient_at (cd, j, xjy, djy), ntheta * cdescent_scale2 (cd, j));
+}
+
+/*** return step-size for updating beta(j) by the proximal gradient step over a block of
+ * coordinates (see block.c), where xjmu = X(:,j)' * mu and djnu = D(:,j)' * nu are given
+ * at the beginning of the step, and the curvature of the coordinate is replaced with
+ * the Lipschitz constant lip of the gradient over the block ***/
+double
+cdescent_beta_stepsize_block (const cdescent *cd, const int j, const double xjmu, const double djnu, const double lip)
+{
+	return prox_step (cd, j, cdescent_gradient_at (cd, j, xjmu, djnu), lip);
 }
@@ -17,71 +17,57 @@
 extern void		update_intercept (cdescent *cd);
 extern void		cdescent_update (cdescent *cd, int j, double *amax_eta);
 extern void		cdescent_update_atomic (cdescent *cd, int j, double *amax_eta);
+/* rowwise.c */
+extern void		cdescent_update_rowwise (cdescent *cd, const int *index, double *amax_eta);
+/* sampler.c */
+extern int		*cdescent_sample_coordinates (cdescent *cd, int *nsel);
+/* cyclic.c */
+extern bool		cdescent_do_update_once_cycle_cyclic (cdescent *cd);
 
-/* swap array[i] <-> array[j] */
-static void
-swap (int *a, int *b)
-{
-	int	tmp = *a;
-	*a = *b;
-	*b = tmp;
-	return;
-}
-
-/* array shuffling which implements Fisher-Yates algorithm */
-static void
-shuffle (const int size, int array[])
-{
-	int		i, j;
-	int		*p = &array[0];
-	int		*q = p;
-	for (i = 0; i < size - 1; i++) {
-		j = i + rand () % (size - i);
-		swap (p + j, q++);
-	}
-	return;
-}
-
-/* create uniformly distributed random sequence */
-static int *
-uniform_random_sequence (const int size)
-{
-	int		i;
-	int		*array = (int *) malloc (size * sizeof (int));
-	for (i = 0; i < size; i++) array[i] = i;
-	shuffle (size, array);
-	return array;
-}
-
-/*** progress stochastic coordinate descent update for one full cycle ***/
+/*** progress stochastic coordinate descent update for one full cycle.
+ * This function is executed by all threads of the worker team
+ * (see cdescent_do_update_one_cycle), and the serial parts are done by a single thread.
+ * If coordinates are sampled in proportion to the curvature, some coordinates
+ * may not be selected in a cycle, so convergence is confirmed by a cyclic update ***/
 bool
 cdescent_do_update_once_cycle_stochastic (cdescent *cd)
 {
 	int		j;
-	int		n = *cd->n;
-	double	amax_eta;	// max of |eta(j)| = |beta_new(j) - beta_prev(j)|
-	int		*index = uniform_random_sequence (*cd->n);
+	int		nsel;
+	// buffer of selected coordinates is shared by the team
+	int		*index = cdescent_sample_coordinates (cd, &nsel);
 
-	/* b = (sum(y) - sum(X) * beta) / m */
-	if (cd->use_intercept) update_intercept (cd);
+#pragma omp single
+	{
+		/* b = (sum(y) - sum(X) * beta) / m */
+		if (cd->use_intercept) update_intercept (cd);
 
-	amax_eta = 0.;
+		// max of |eta(j)| = |beta_new(j) - beta_prev(j)|
+		cd->amax_eta = 0.;
+	}
 
 	/*** single "one-at-a-time" update of cyclic coordinate descent
 	 * the following code was referring to shotgun by A.Kyrola,
 	 * https://github.com/akyrola/shotgun ****/
-	if (cd->parallel) {
-#pragma omp parallel for
-		for (j = 0; j < n; j++) cdescent_update_atomic (cd, index[j], &amax_eta);
+	if (cd->row_parallel) {
+		// exact update, each coordinate update is parallelized over the rows
+		cdescent_update_rowwise (cd, index, &cd->amax_eta);
+	} else if (cd->parallel) {
+#pragma omp for
+		for (j = 0; j < nsel; j++) cdescent_update_atomic (cd, index[j], &cd->amax_eta);
 	} else {
-		for (j = 0; j < n; j++) cdescent_update (cd, index[j], &amax_eta);
+#pragma omp single
+		for (j = 0; j < nsel; j++) cdescent_update (cd, index[j], &cd->amax_eta);
 	}
 
-	cd->nrm1 = mm_real_xj_asum (cd->beta, 0);
+#pragma omp single
+	{
+		if (!cd->was_modified) cd->was_modified = true;
 
-	if (!cd->was_modified) cd->was_modified = true;
+		cd->cycle_converged = (cd->amax_eta < cd->tolerance);
+	}
 
-	free (index);
+	if (cd->sampler->importance && cd->cycle_converged) return cdescent_do_update_once_cycle_cyclic (cd);
 
-	return (amax_eta < cd->tolerance);
+	return cd->cycle_converged;
 }
@@ -0,0 +1,291 @@
+/*
+ * svrg.c
+ *
+ *  Created on: 2026/10/18
+ *      Author: utsugi
+ */
+
+#include <stdlib.h>
+#include <math.h>
+#include <cdescent.h>
+#include <mmreal.h>
+
+#include "private/private.h"
+#include "private/random.h"
+
+/* update.c */
+extern void		update_intercept (cdescent *cd);
+/* stepsize.c */
+extern double	cdescent_gradient_at (const cdescent *cd, const int j, const double xjmu, const double djnu);
+/* regression.c */
+extern double	cdescent_objective (const cdescent *cd);
+
+/* number of power iterations to estimate the squared spectral norms */
+#define SVRG_POWER_ITER	20
+/* safety factor of the estimated spectral norms, since power iteration underestimates them */
+#define SVRG_SAFETY		1.1
+/* max length of an epoch relative to nbatches */
+#define SVRG_MAX_GROWTH	64
+
+/* allocate svrg object */
+static svrg *
+svrg_alloc (void)
+{
+	svrg	*s = (svrg *) malloc (sizeof (svrg));
+	if (s == NULL) return NULL;
+
+	s->batch = 0;
+	s->nbatches = 0;
+	s->nsteps = 0;
+
+	s->lambda = 0.;
+	s->obj = 0.;
+
+	s->lx = 0.;
+	s->ld = 0.;
+
+	s->z0 = NULL;
+	s->beta0 = NULL;
+	s->delta = NULL;
+	s->v = NULL;
+	s->t = NULL;
+	s->ddelta = NULL;
+	s->dtd = NULL;
+
+	return s;
+}
+
+/* x := x / ||x||, return ||x|| */
+static double
+normalize (const int n, double *x)
+{
+	double	nrm = dnrm2_ (&n, x, &ione);
+	if (nrm > 0.) {
+		double	alpha = 1. / nrm;
+		dscal_ (&n, &alpha, x, &ione);
+	}
+	return nrm;
+}
+
+/* estimate ||A||^2 of the mb x n submatrix A = X(i0:i0+mb-1, :) by power iteration,
+ * v (size n) and t (size >= mb) are work spaces */
+static double
+rows_nrm2 (const mm_dense *x, const int i0, const int mb, double *v, double *t)
+{
+	int		k;
+	int		n = x->n;
+	double	val = 0.;
+	double	*xi = x->data + i0;
+
+	for (k = 0; k < n; k++) v[k] = 1.;
+	normalize (n, v);
+	for (k = 0; k < SVRG_POWER_ITER; k++) {
+		// v = A' * A * v / ||A' * A * v||
+		dgemv_ ("N", &mb, &n, &done, xi, &x->m, v, &ione, &dzero, t, &ione);
+		dgemv_ ("T", &mb, &n, &done, xi, &x->m, t, &ione, &dzero, v, &ione);
+		val = normalize (n, v);
+		if (val <= 0.) break;
+	}
+	return val;
+}
+
+/* estimate ||D||^2 by power iteration */
+static double
+penalty_nrm2 (const penalty *d, mm_dense *v, mm_dense *t)
+{
+	int		k;
+	double	val = 0.;
+
+	mm_real_set_all (v, 1.);
+	normalize (v->m, v->data);
+	for (k = 0; k < SVRG_POWER_ITER; k++) {
+		penalty_dot_y (false, 1., d, v, 0., t);
+		penalty_dot_y (true, 1., d, t, 0., v);
+		val = normalize (v->m, v->data);
+		if (val <= 0.) break;
+	}
+	return val;
+}
+
+/*** create new svrg object, where the rows of X are divided into mini-batches
+ * of batch consecutive rows ***/
+svrg *
+svrg_new (const cdescent *cd, const int batch)
+{
+	int		k;
+	int		m = *cd->m;
+	int		n = *cd->n;
+	svrg	*s;
+
+	if (batch <= 0) error_and_exit ("svrg_new", "size of mini-batch must be > 0.", __FILE__, __LINE__);
+	if (!cd->lreg->x || !mm_real_is_dense (cd->lreg->x) || mm_real_is_symmetric (cd->lreg->x))
+		error_and_exit ("svrg_new", "X must be dense general.", __FILE__, __LINE__);
+
+	s = svrg_alloc ();
+	if (s == NULL) error_and_exit ("svrg_new", "failed to allocate object.", __FILE__, __LINE__);
+
+	s->batch = (batch < m) ? batch : m;
+	s->nbatches = (m + s->batch - 1) / s->batch;
+	s->nsteps = s->nbatches;
+
+	s->z0 = vector_new (n);
+	s->beta0 = vector_new (n);
+	s->delta = vector_new (n);
+	s->v = vector_new (n);
+	s->t = vector_new (s->batch);
+	if (!cd->is_regtype_lasso) {
+		s->ddelta = vector_new (cd->lreg->pen->m);
+		s->dtd = vector_new (n);
+	}
+
+	/* smoothness of the stochastic gradient nbatches * X_B' * X_B over the mini-batches B */
+	for (k = 0; k < s->nbatches; k++) {
+		int		i0 = k * s->batch;
+		int		mb = (i0 + s->batch <= m) ? s->batch : m - i0;
+		double	lk = rows_nrm2 (cd->lreg->x, i0, mb, s->v->data, s->t->data);
+		if (s->lx < lk) s->lx = lk;
+	}
+	s->lx *= SVRG_SAFETY * (double) s->nbatches;
+	if (!cd->is_regtype_lasso) s->ld = SVRG_SAFETY * penalty_nrm2 (cd->lreg->pen, s->v, s->ddelta);
+
+	return s;
+}
+
+/*** free svrg object ***/
+void
+svrg_free (svrg *s)
+{
+	if (s) {
+		if (s->z0) mm_real_free (s->z0);
+		if (s->beta0) mm_real_free (s->beta0);
+		if (s->delta) mm_real_free (s->delta);
+		if (s->v) mm_real_free (s->v);
+		if (s->t) mm_real_free (s->t);
+		if (s->ddelta) mm_real_free (s->ddelta);
+		if (s->dtd) mm_real_free (s->dtd);
+		free (s);
+	}
+	return;
+}
+
+/* take snapshot beta0 = beta and z0 = - (gradient of smooth part at beta0) */
+static void
+take_snapshot (cdescent *cd)
+{
+	int		j;
+	svrg	*s = cd->svrg;
+
+	mm_real_memcpy (s->beta0, cd->beta);
+	mm_real_set_all (s->delta, 0.);
+
+	// v = X' * mu, dtd = D' * nu
+	mm_real_x_dot_yk (true, 1., cd->lreg->x, cd->mu, 0, 0., s->v);
+	if (!cd->is_regtype_lasso) penalty_dot_y (true, 1., cd->lreg->pen, cd->nu, 0., s->dtd);
+	for (j = 0; j < *cd->n; j++)
+		s->z0->data[j] = cdescent_gradient_at (cd, j, s->v->data[j], (s->dtd) ? s->dtd->data[j] : 0.);
+	return;
+}
+
+/* proximal gradient step beta = prox(beta + step * z) for k-th mini-batch, where
+ * z = z0 - nbatches * X_B' * X_B * delta - lambda2 * D' * D * delta, delta = beta - beta0
+ * is the variance reduced estimate of the negative gradient */
+static void
+inner_step (cdescent *cd, const int k, const double step)
+{
+	int		j;
+	svrg	*s = cd->svrg;
+	int		m = *cd->m;
+	int		n = *cd->n;
+	int		i0 = k * s->batch;
+	int		mb = (i0 + s->batch <= m) ? s->batch : m - i0;
+	double	scale = - (double) s->nbatches;
+	double	*xi = cd->lreg->x->data + i0;
+
+	// v = z0 - nbatches * X_B' * (X_B * delta)
+	mm_real_memcpy (s->v, s->z0);
+	dgemv_ ("N", &mb, &n, &done, xi, &m, s->delta->data, &ione, &dzero, s->t->data, &ione);
+	dgemv_ ("T", &mb, &n, &scale, xi, &m, s->t->data, &ione, &done, s->v->data, &ione);
+	if (!cd->is_regtype_lasso) {
+		// v -= lambda2 * D' * (D * delta)
+		penalty_dot_y (false, 1., cd->lreg->pen, s->delta, 0., s->ddelta);
+		penalty_dot_y (true, - cd->lambda2, cd->lreg->pen, s->ddelta, 1., s->v);
+	}
+
+	for (j = 0; j < n; j++) {
+		double	val;
+		double	betaj = cd->beta->data[j];
+		double	gamma = step * cd->lambda1;
+		double	z = betaj + step * s->v->data[j];
+		double	etaj;
+		if (cd->w) gamma *= cd->w->data[j];
+		// soft thresholding
+		etaj = ((gamma < fabs (z)) ? ((z > 0.) ? z - gamma : z + gamma) : 0.) - betaj;
+		// constraint, the projection of soft thresholded value is the proximal point
+		if (cd->cfunc && !cd->cfunc (cd, j, etaj, &val)) etaj = val - betaj;
+		cd->beta->data[j] = betaj + etaj;
+		s->delta->data[j] = cd->beta->data[j] - s->beta0->data[j];
+	}
+	return;
+}
+
+/*** progress proximal stochastic variance reduced gradient method (Prox-SVRG, Xiao and Zhang, 2014)
+ * for one epoch, i.e. nsteps proximal gradient steps with randomly selected mini-batches of rows.
+ * At the start of epoch, the full gradient at the snapshot beta0 = beta is calculated,
+ * and each step uses z0 - nbatches * X_B' * X_B * (beta - beta0) as the gradient estimate.
+ * The full gradient and mu = X * beta at the end of epoch cost O(m * n) each,
+ * so that the epoch starts from nbatches steps at each lambda and is doubled
+ * while the objective function decreases (SVRG++, Allen-Zhu and Yuan, 2016),
+ * and these full passes are amortized over the steps.
+ * The objective function is quadratic in the error of beta near the minimum, so that
+ * the epoch is converged if the relative decrease of the objective function < tolerance^2 ***/
+bool
+cdescent_do_update_once_cycle_svrg (cdescent *cd)
+{
+#pragma omp single
+	{
+		int		k;
+		int		j;
+		svrg	*s = cd->svrg;
+		double	step = 1. / (s->lx + cd->lambda2 * s->ld);
+		double	obj;
+		xoshiro256	*rng = cd->sampler->rng;
+
+		// epochs are started at new lambda, mu and nu are kept with beta
+		if (s->lambda != cd->lambda) {
+			s->lambda = cd->lambda;
+			s->nsteps = s->nbatches;
+			s->obj = cdescent_objective (cd);
+		}
+
+		/* b = (sum(y) - sum(X) * beta) / m */
+		if (cd->use_intercept) update_intercept (cd);
+
+		take_snapshot (cd);
+		for (k = 0; k < s->nsteps; k++) inner_step (cd, xoshiro256_int (rng, s->nbatches), step);
+
+		// mu = X * beta, nu = D * beta
+		mm_real_x_dot_yk (false, 1., cd->lreg->x, cd->beta, 0, 0., cd->mu);
+		if (!cd->is_regtype_lasso) penalty_dot_y (false, 1., cd->lreg->pen, cd->beta, 0., cd->nu);
+
+		cd->amax_eta = 0.;
+		for (j = 0; j < *cd->n; j++) {
+			double	abs_etaj = fabs (s->delta->data[j]);
+			if (cd->amax_eta < abs_etaj) cd->amax_eta = abs_etaj;
+		}
+
+		if (!cd->was_modified) cd->was_modified = true;
+
+		obj = cdescent_objective (cd);
+		if (obj <= s->obj) {
+			cd->cycle_converged = (s->obj - obj <= pow (cd->tolerance, 2.) * s->obj);
+			if (s->nsteps < SVRG_MAX_GROWTH * s->nbatches) s->nsteps *= 2;
+		} else {
+			// the variance of the estimate is not small enough, start again from short epoch
+			cd->cycle_converged = false;
+			s->nsteps = s->nbatches;
+		}
+		s->obj = obj;
+	}
+
+	return cd->cycle_converged;
+}
@@ -0,0 +1,176 @@
+/*
+ * sweep.c
+ *
+ *  Created on: 2026/10/18
+ *      Author: utsugi
+ */
+
+#include <stdlib.h>
+#include <math.h>
+#include <cdescent.h>
+#include <mmreal.h>
+
+#include "private/private.h"
+
+/* kind of penalty operator D of the specialized sweep */
+enum {
+	SWEEP_PENALTY_NONE   = 0,	// Lasso, no D
+	SWEEP_PENALTY_SPARSE = 1,	// D is stored in sparse general, inlined
+	SWEEP_PENALTY_IMPLICIT = 2	// D is implicit operator (see penalty.c)
+};
+
+/* kind of constraint of the specialized sweep */
+enum {
+	SWEEP_CONSTRAINT_NONE = 0,	// no constraint
+	SWEEP_CONSTRAINT_FUNC = 1,	// constraint by cd->cfunc
+	SWEEP_CONSTRAINT_BOX  = 2	// box constraint cd->lower <= beta <= cd->upper, inlined
+};
+
+#ifdef __GNUC__
+#define SWEEP_INLINE	static inline __attribute__((always_inline))
+#else
+#define SWEEP_INLINE	static inline
+#endif
+
+/* one sweep of serial cyclic coordinate descent, which is the same as
+ * cdescent_update of update.c and cdescent_beta_stepsize of stepsize.c, where
+ * pkind:      SWEEP_PENALTY_*
+ * normalized: cd->lreg->xnormalized
+ * intercept:  cd->use_intercept && !cd->lreg->xcentered
+ * weight:     cd->w != NULL
+ * constraint: SWEEP_CONSTRAINT_*
+ * X must be dense general. All flags are constants at each instance below,
+ * so that the branches on them are removed by the compiler,
+ * and neither the function pointer of the step-size nor the checks of mm_real_* are used */
+SWEEP_INLINE void
+sweep_body (cdescent *cd, const int pkind, const bool normalized, const bool intercept,
+			const bool weight, const int constraint)
+{
+	int				j;
+	const mm_dense	*x = cd->lreg->x;
+	const penalty	*pen = cd->lreg->pen;
+	const mm_sparse	*d = (pkind == SWEEP_PENALTY_SPARSE) ? pen->d : NULL;
+	int				m = x->m;
+	int				n = x->n;
+	const double	*c = cd->lreg->c->data;
+	const double	*xtx = cd->lreg->xtx;
+	const double	*dtd = cd->lreg->dtd;
+	const double	*sx = cd->lreg->sx;
+	const double	*w = (weight) ? cd->w->data : NULL;
+	double			*beta = cd->beta->data;
+	double			*mu = cd->mu->data;
+	double			*nu = (pkind == SWEEP_PENALTY_NONE) ? NULL : cd->nu->data;
+	double			lambda1 = cd->lambda1;
+	double			lambda2 = cd->lambda2;
+	double			b0 = cd->b0;
+	double			amax_eta = cd->amax_eta;
+	double			xjmu = ddot_ (&m, x->data, &ione, mu, &ione);
+
+	for (j = 0; j < n; j++) {
+		const double	*xj = x->data + (size_t) j * m;
+		double			scale2 = (normalized) ? 1. : xtx[j];
+		double			z = c[j] - xjmu;
+		double			gamma;
+		double			etaj;
+		int				p;
+
+		/* gradient and curvature, see cdescent_gradient_at and cdescent_scale2 */
+		if (intercept) {
+			if (fabs (b0) > 0.) z -= sx[j] * b0;
+		}
+		if (pkind != SWEEP_PENALTY_NONE) {
+			double	djnu = 0.;
+			if (pkind == SWEEP_PENALTY_SPARSE) {
+				for (p = d->p[j]; p < d->p[j + 1]; p++) djnu += d->data[p] * nu[d->i[p]];
+			} else djnu = penalty_dj_trans_dot_y (pen, j, cd->nu);
+			z -= lambda2 * djnu;
+			scale2 += lambda2 * dtd[j];
+		}
+
+		/* eta(j) = S(z / scale2 + beta(j), w(j) * lambda1 / scale2) - beta(j) */
+		gamma = lambda1 / scale2;
+		if (weight) gamma *= w[j];
+		z = z / scale2 + beta[j];
+		etaj = ((gamma < fabs (z)) ? ((z > 0.) ? z - gamma : z + gamma) : 0.) - beta[j];
+
+		if (fabs (etaj) < DBL_EPSILON) etaj = 0.;
+		else {
+			double	val;
+			if (constraint == SWEEP_CONSTRAINT_FUNC && !cd->cfunc (cd, j, etaj, &val)) {
+				etaj = - beta[j] + val;
+				beta[j] = val;
+			} else if (constraint == SWEEP_CONSTRAINT_BOX && beta[j] + etaj < cd->lower[j]) {
+				etaj = - beta[j] + cd->lower[j];
+				beta[j] = cd->lower[j];
+			} else if (constraint == SWEEP_CONSTRAINT_BOX && beta[j] + etaj > cd->upper[j]) {
+				etaj = - beta[j] + cd->upper[j];
+				beta[j] = cd->upper[j];
+			} else beta[j] += etaj;
+			// nu += eta(j) * D(:,j)
+			if (pkind == SWEEP_PENALTY_SPARSE) {
+				for (p = d->p[j]; p < d->p[j + 1]; p++) nu[d->i[p]] += etaj * d->data[p];
+			} else if (pkind == SWEEP_PENALTY_IMPLICIT) penalty_adjpy (etaj, pen, j, cd->nu);
+			if (amax_eta < fabs (etaj)) amax_eta = fabs (etaj);
+		}
+
+		/* mu += eta(j) * X(:,j), and X(:,j+1)' * mu for the next coordinate */
+		if (j + 1 < n) {
+			if (etaj != 0.) xjmu = axpy_dot (m, etaj, xj, xj + m, mu);
+			else xjmu = ddot_ (&m, xj + m, &ione, mu, &ione);
+		} else if (etaj != 0.) daxpy_ (&m, &etaj, xj, &ione, mu, &ione);
+	}
+	cd->amax_eta = amax_eta;
+	return;
+}
+
+/* instances of sweep_body for all combinations of the flags */
+#define SWEEP_NAME(p, n, i, w, c)	sweep_p##p##_n##n##_i##i##_w##w##_c##c
+#define SWEEP_DEFINE(p, n, i, w, c)	\
+	static void SWEEP_NAME(p, n, i, w, c) (cdescent *cd) { sweep_body (cd, p, n, i, w, c); }
+
+#define SWEEP_DEFINE_C(p, n, i, w)	SWEEP_DEFINE(p, n, i, w, 0) SWEEP_DEFINE(p, n, i, w, 1) SWEEP_DEFINE(p, n, i, w, 2)
+#define SWEEP_DEFINE_W(p, n, i)		SWEEP_DEFINE_C(p, n, i, 0) SWEEP_DEFINE_C(p, n, i, 1)
+#define SWEEP_DEFINE_I(p, n)		SWEEP_DEFINE_W(p, n, 0) SWEEP_DEFINE_W(p, n, 1)
+#define SWEEP_DEFINE_N(p)			SWEEP_DEFINE_I(p, 0) SWEEP_DEFINE_I(p, 1)
+
+SWEEP_DEFINE_N(0)
+SWEEP_DEFINE_N(1)
+SWEEP_DEFINE_N(2)
+
+#define SWEEP_TABLE_C(p, n, i, w)	{ SWEEP_NAME(p, n, i, w, 0), SWEEP_NAME(p, n, i, w, 1), SWEEP_NAME(p, n, i, w, 2) }
+#define SWEEP_TABLE_W(p, n, i)		{ SWEEP_TABLE_C(p, n, i, 0), SWEEP_TABLE_C(p, n, i, 1) }
+#define SWEEP_TABLE_I(p, n)			{ SWEEP_TABLE_W(p, n, 0), SWEEP_TABLE_W(p, n, 1) }
+#define SWEEP_TABLE_N(p)			{ SWEEP_TABLE_I(p, 0), SWEEP_TABLE_I(p, 1) }
+
+/* sweeps[pkind][normalized][intercept][weight][constraint] */
+static const sweep_func	sweeps[3][2][2][2][3] = { SWEEP_TABLE_N(0), SWEEP_TABLE_N(1), SWEEP_TABLE_N(2) };
+
+/*** select the specialized sweep of the serial cyclic rule for current settings of cd,
+ * and set it to cd->sweep. This is called once for each lambda.
+ * If no specialized sweep is available, e.g. X is sparse or not in memory, cd->sweep is set to NULL ***/
+void
+cdescent_select_sweep (cdescent *cd)
+{
+	int		pkind = SWEEP_PENALTY_NONE;
+	int		normalized = (cd->lreg->xnormalized) ? 1 : 0;
+	int		intercept = (cd->use_intercept && !cd->lreg->xcentered) ? 1 : 0;
+	int		weight = (cd->w) ? 1 : 0;
+	int		constraint = SWEEP_CONSTRAINT_NONE;
+
+	cd->sweep = NULL;
+	if (!cd->lreg->x || !mm_real_is_dense (cd->lreg->x) || mm_real_is_symmetric (cd->lreg->x)) return;
+	if (!cd->is_regtype_lasso) {
+		const penalty	*pen = cd->lreg->pen;
+		if (penalty_is_implicit (pen)) pkind = SWEEP_PENALTY_IMPLICIT;
+		else if (mm_real_is_sparse (pen->d) && !mm_real_is_symmetric (pen->d)) pkind = SWEEP_PENALTY_SPARSE;
+		else return;
+	}
+	// xtx is used if X is not normalized, and sx is used if X is not centered
+	if (!normalized && cd->lreg->xtx == NULL) return;
+	if (intercept && cd->lreg->sx == NULL) return;
+
+	if (cd->cfunc) constraint = (cd->lower) ? SWEEP_CONSTRAINT_BOX : SWEEP_CONSTRAINT_FUNC;
+
+	cd->sweep = sweeps[pkind][normalized][intercept][weight][constraint];
+	return;
+}
@@ -13,8 +13,12 @@
 #include "private/private.h"
 #include "private/atomic.h"
 
+/* cdescent.c */
+extern void			cdescent_copy_beta_in_original_scale (const cdescent *cd, mm_dense *dest);
 /* stepsize.c */
 extern double		cdescent_beta_stepsize (const cdescent *cd, const int j);
+extern double		cdescent_beta_stepsize_xjmu (const cdescent *cd, const int j, const double xjmu);
+extern double		cdescent_z_stepsize (const cdescent *cd, const int j, const double xjy, const double djy, const double ntheta);
 
 /* update intercept: (sum (y) - sum(X) * beta) / m
  * intercept is calculated in original scale */
@@ -26,9 +30,9 @@ update_intercept (cdescent *cd)
 	if (!cd->lreg->ycentered && cd->lreg->sy) cd->b0 += *(cd->lreg->sy);
 	// b -= bar(X) * beta
 	if (!cd->lreg->xcentered && cd->lreg->sx) {
-		mm_dense	*beta = cdescent_get_beta_in_original_scale (cd);
-		cd->b0 -= ddot_ (cd->n, cd->lreg->sx, &ione, beta->data, &ione);
-		mm_real_free (beta);
+		// beta in original scale is stored in the workspace, no allocation
+		cdescent_copy_beta_in_original_scale (cd, cd->work->beta);
+		cd->b0 -= ddot_ (cd->n, cd->lreg->sx, &ione, cd->work->beta->data, &ione);
 	}
 	if (fabs (cd->b0) > DBL_EPSILON) cd->b0 /= (double) *cd->m;
 	return;
@@ -60,9 +64,9 @@ cdescent_update (cdescent *cd, int j, double *amax_eta)
 	// update beta: beta(j) += eta(j)
 	update_betaj (cd, j, &etaj, &abs_etaj);
 	// update mu (= X * beta): mu += eta(j) * X(:,j)
-	mm_real_axjpy (etaj, cd->lreg->x, j, cd->mu);
+	provider_axjpy (etaj, cd->lreg->prov, j, cd->mu);
 	// update nu (= D * beta) if lambda2 != 0 && cd->nu != NULL: nu += eta(j) * D(:,j)
-	if (!cd->is_regtype_lasso) mm_real_axjpy (etaj, cd->lreg->d, j, cd->nu);
+	if (!cd->is_regtype_lasso) penalty_adjpy (etaj, cd->lreg->pen, j, cd->nu);
 	// update max( |eta| )
 	if (*amax_eta < abs_etaj) *amax_eta = abs_etaj;
 
@@ -82,11 +86,52 @@ cdescent_update_atomic (cdescent *cd, int j, double *amax_eta)
 	// update beta: beta(j) += etaj
 	update_betaj (cd, j, &etaj, &abs_etaj);
 	// update mu (= X * beta): mu += etaj * X(:,j)
-	mm_real_axjpy_atomic (etaj, cd->lreg->x, j, cd->mu);
+	provider_axjpy_atomic (etaj, cd->lreg->prov, j, cd->mu);
 	// update nu (= D * beta) if lambda2 != 0 && cd->nu != NULL: nu += etaj * D(:,j)
-	if (!cd->is_regtype_lasso) mm_real_axjpy_atomic (etaj, cd->lreg->d, j, cd->nu);
+	if (!cd->is_regtype_lasso) penalty_adjpy_atomic (etaj, cd->lreg->pen, j, cd->nu);
 	// update max( |etaj| )
 	atomic_max (amax_eta, abs_etaj);
 
 	return;
 }
+
+/* update beta, nu and amax_eta for given xjmu = X(:,j)' * mu, and return eta(j).
+ * mu is not updated here, so the caller must do mu += eta(j) * X(:,j) */
+double
+cdescent_update_beta_nu (cdescent *cd, int j, const double xjmu, double *amax_eta)
+{
+	// eta(j) = beta_new(j) - beta_prev(j)
+	double	etaj = cdescent_beta_stepsize_xjmu (cd, j, xjmu);
+	double	abs_etaj = fabs (etaj);
+
+	if (abs_etaj < DBL_EPSILON) return 0.;
+
+	// update beta: beta(j) += eta(j)
+	update_betaj (cd, j, &etaj, &abs_etaj);
+	// update nu (= D * beta) if lambda2 != 0 && cd->nu != NULL: nu += eta(j) * D(:,j)
+	if (!cd->is_regtype_lasso) penalty_adjpy (etaj, cd->lreg->pen, j, cd->nu);
+	// update max( |eta| )
+	if (*amax_eta < abs_etaj) *amax_eta = abs_etaj;
+
+	return etaj;
+}
+
+/* update z(j) of accelerated coordinate descent, which is held in cd->beta during the sweep,
+ * and X * z, D * z held in cd->mu and cd->nu. Return t(j) = z_new(j) - z_prev(j) */
+double
+cdescent_update_z (cdescent *cd, int j, const double xjy, const double djy, const double ntheta)
+{
+	double	tj = cdescent_z_stepsize (cd, j, xjy, djy, ntheta);
+	double	abs_tj = fabs (tj);
+
+	if (abs_tj < DBL_EPSILON) return 0.;
+
+	// update z: z(j) += t(j), the constraint is also applied to z
+	update_betaj (cd, j, &tj, &abs_tj);
+	// X * z += t(j) * X(:,j)
+	provider_axjpy (tj, cd->lreg->prov, j, cd->mu);
+	// D * z += t(j) * D(:,j)
+	if (!cd->is_regtype_lasso) penalty_adjpy (tj, cd->lreg->pen, j, cd->nu);
+
+	return tj;
+}
@@ -0,0 +1,42 @@
+/*
+ * test_alloc.c
+ *
+ *  Check that the solvers do not allocate in the steady state:
+ *  the path is solved once to allocate the work spaces, and solved again,
+ *  then cdescent_num_allocated must not change in the second pass.
+ *
+ *  Created on: 2026/10/19
+ *      Author: utsugi
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "testutil.h"
+
+int
+main (void)
+{
+	int				k;
+	test_problem	*pr = test_problem_new (6, 5, 4, 80);
+
+	for (k = 0; k < test_num_rules; k++) {
+		long		nalloc;
+		char		msg[BUFSIZ];
+		cdescent	*cd = test_cdescent_new (pr, 1.e-6, test_rules[k].parallel);
+
+		test_rules[k].set (cd, pr);
+		test_solve_path (cd, NULL);
+
+		nalloc = cdescent_num_allocated ();
+		test_solve_path (cd, NULL);
+		nalloc = cdescent_num_allocated () - nalloc;
+
+		sprintf (msg, "%ld allocated in steady state", nalloc);
+		test_check (nalloc == 0, test_rules[k].name, msg);
+		cdescent_free (cd);
+	}
+	test_problem_free (pr);
+
+	return (test_num_failed () > 0) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,124 @@
+/*
+ * test_provider.c
+ *
+ *  Check that the solution path of the columns of X served by the providers
+ *  agrees with that of X in memory (the matrix provider).
+ *
+ *  Created on: 2026/10/19
+ *      Author: utsugi
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "testutil.h"
+
+/* container written in the current directory */
+#define XMATFILE_NAME	"test_provider.xmat"
+
+/* tolerance of the tests */
+#define TOL			1.e-8
+/* max difference allowed between the paths, where the parallel updates
+ * are applied in arbitrary order, so they converge to other points within the tolerance */
+#define MAX_DIFF			1.e-10
+#define MAX_DIFF_PARALLEL	(100. * TOL)
+
+/* provider_column_func which copies X(:,j) of the dense matrix data */
+static void
+matrix_column (const int j, double *xj, void *data)
+{
+	mm_dense	*x = (mm_dense *) data;
+	memcpy (xj, x->data + (size_t) j * x->m, x->m * sizeof (double));
+	return;
+}
+
+/* solve the path of lreg by cyclic coordinate descent,
+ * or block coordinate descent of blocks of nb columns if nb > 0 */
+static void
+solve_path (linregmodel *lreg, const int nb, const bool parallel, mm_dense **path)
+{
+	cdescent	*cd = cdescent_new (0.9, lreg, TOL, 1000000, parallel);
+	cdescent_not_use_intercept (cd);
+	if (nb > 0) cdescent_set_block (cd, nb);
+	test_solve_path (cd, path);
+	cdescent_free (cd);
+	return;
+}
+
+/* compare the path of prov with the reference */
+static void
+check_provider (const char *name, const test_problem *pr, provider *prov, const int nb, const bool parallel,
+	mm_dense **ref)
+{
+	char		msg[BUFSIZ];
+	double		diff;
+	mm_dense	*path[TEST_NLAMBDAS];
+	linregmodel	*lreg = linregmodel_new_with_provider (pr->y, prov, pr->pen, DO_NORMALIZING_X);
+
+	solve_path (lreg, nb, parallel, path);
+	diff = test_path_max_diff (ref, path);
+	sprintf (msg, "max diff from matrix = %.3e", diff);
+	test_check (diff < ((parallel) ? MAX_DIFF_PARALLEL : MAX_DIFF), name, msg);
+
+	test_path_free (path);
+	linregmodel_free (lreg);
+	return;
+}
+
+int
+main (void)
+{
+	int				m = 80;
+	size_t			xjsize = m * sizeof (double);
+	test_problem	*pr = test_problem_new (6, 5, 4, m);
+	int				n = pr->x->n;
+	int				nb = pr->nx * pr->ny;
+	mm_dense		*ref[TEST_NLAMBDAS];
+	mm_dense		*ref_block[TEST_NLAMBDAS];
+	provider		*prov;
+
+	solve_path (pr->lreg, 0, false, ref);
+	// blocks are the depth layers
+	solve_path (pr->lreg, nb, false, ref_block);
+
+	// all the columns are resident, or only 8 columns are kept so that the pool is replaced
+	check_provider ("function", pr, provider_new_function (m, n, matrix_column, pr->x, n * xjsize), 0, false, ref);
+	check_provider ("function small pool", pr, provider_new_function (m, n, matrix_column, pr->x, 8 * xjsize), 0, false, ref);
+	check_provider ("function parallel", pr, provider_new_function (m, n, matrix_column, pr->x, 8 * xjsize), 0, true, ref);
+	// columns are read ahead while they are normalized by linregmodel_new_with_provider
+	prov = provider_new_function (m, n, matrix_column, pr->x, 8 * xjsize);
+	provider_read_ahead (prov, 4);
+	check_provider ("function read ahead", pr, prov, 0, false, ref);
+
+	// columns are read from the container of tiles of 16 columns
+	test_write_xmatfile (pr, XMATFILE_NAME, MM_REAL_XMAT_FLOAT64, 16, 0);
+	check_provider ("xmatfile", pr, provider_new_xmatfile (XMATFILE_NAME, n * xjsize), 0, false, ref);
+	check_provider ("xmatfile small pool", pr, provider_new_xmatfile (XMATFILE_NAME, 8 * xjsize), 0, false, ref);
+	check_provider ("xmatfile parallel", pr, provider_new_xmatfile (XMATFILE_NAME, 8 * xjsize), 0, true, ref);
+	check_provider ("xmatfile mmap", pr, provider_new_xmatfile_mmap (XMATFILE_NAME), 0, false, ref);
+	check_provider ("xmatfile mmap parallel", pr, provider_new_xmatfile_mmap (XMATFILE_NAME), 0, true, ref);
+	remove (XMATFILE_NAME);
+
+	// tiles of a depth layer, whose rows are divided into row blocks of 30 rows,
+	// are updated by block coordinate descent as l1l2inv_xmat -B
+	test_write_xmatfile (pr, XMATFILE_NAME, MM_REAL_XMAT_FLOAT64, nb, 30);
+	check_provider ("xmatfile row blocks", pr, provider_new_xmatfile (XMATFILE_NAME, n * xjsize), nb, false, ref_block);
+	check_provider ("xmatfile row blocks mmap", pr, provider_new_xmatfile_mmap (XMATFILE_NAME), nb, false, ref_block);
+	remove (XMATFILE_NAME);
+
+	// a column is larger than the size of a tile, and a row block of 4 rows of a tile is the size,
+	// so the tiles of 16 columns are the blocks of block coordinate descent as l1l2inv_xmat -B -T
+	nb = mm_real_xmatfile_tile_width (MM_REAL_XMAT_FLOAT64, m, 4, 16 * 4 * sizeof (double));
+	test_path_free (ref_block);
+	solve_path (pr->lreg, nb, false, ref_block);
+	test_write_xmatfile (pr, XMATFILE_NAME, MM_REAL_XMAT_FLOAT64, nb, 4);
+	check_provider ("xmatfile narrow row blocks", pr, provider_new_xmatfile (XMATFILE_NAME, n * xjsize), nb, false, ref_block);
+	remove (XMATFILE_NAME);
+
+	test_path_free (ref_block);
+	test_path_free (ref);
+	test_problem_free (pr);
+
+	return (test_num_failed () > 0) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
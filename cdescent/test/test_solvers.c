@@ -0,0 +1,111 @@
+/*
+ * test_solvers.c
+ *
+ *  Check that the solution path of each solver agrees with that of
+ *  cyclic coordinate descent of X in memory.
+ *
+ *  Created on: 2026/10/19
+ *      Author: utsugi
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "testutil.h"
+
+/* tolerance of the tests */
+#define TOL		1.e-7
+
+/* solver of test_rules and the max difference from the path of cyclic coordinate descent */
+typedef struct {
+	const char	*name;
+	double		max_diff;
+} solver_check;
+
+static const solver_check	checks[] = {
+	// the update of the rows distributed to the threads is the same as the serial one up to reassociation
+	{"row parallel", 1.e-12},
+	{"stochastic", 1.e-5},
+	{"importance sampling", 1.e-5},
+	{"importance sampling parallel", 1.e-5},
+	{"greedy", 1.e-5},
+	{"block", 1.e-5},
+	{"svrg", 1.e-5},
+	{"accelerated", 1.e-5},
+	{"anderson", 1.e-5}
+};
+
+/* return the rule of name in test_rules */
+static const test_rule *
+find_rule (const char *name)
+{
+	int		k;
+	for (k = 0; k < test_num_rules; k++) if (strcmp (test_rules[k].name, name) == 0) return test_rules + k;
+	return NULL;
+}
+
+/* solve the path by rule */
+static bool
+solve_path (const test_problem *pr, const test_rule *rule, mm_dense **path)
+{
+	bool		converged;
+	cdescent	*cd = test_cdescent_new (pr, TOL, rule->parallel);
+	rule->set (cd, pr);
+	converged = test_solve_path (cd, path);
+	cdescent_free (cd);
+	return converged;
+}
+
+/* the paths of two runs of rule are bit-identical */
+static void
+check_deterministic (const test_problem *pr, const test_rule *rule)
+{
+	char		name[BUFSIZ];
+	char		msg[BUFSIZ];
+	double		diff;
+	mm_dense	*path1[TEST_NLAMBDAS];
+	mm_dense	*path2[TEST_NLAMBDAS];
+
+	solve_path (pr, rule, path1);
+	solve_path (pr, rule, path2);
+	diff = test_path_max_diff (path1, path2);
+	sprintf (name, "%s deterministic", rule->name);
+	sprintf (msg, "max diff of two runs = %.3e", diff);
+	test_check (diff == 0., name, msg);
+	test_path_free (path1);
+	test_path_free (path2);
+	return;
+}
+
+int
+main (void)
+{
+	int				k;
+	test_problem	*pr = test_problem_new (6, 5, 4, 80);
+	mm_dense		*ref[TEST_NLAMBDAS];
+
+	solve_path (pr, find_rule ("cyclic"), ref);
+
+	for (k = 0; k < sizeof (checks) / sizeof (solver_check); k++) {
+		char			msg[BUFSIZ];
+		double			diff;
+		bool			converged;
+		mm_dense		*path[TEST_NLAMBDAS];
+		const test_rule	*rule = find_rule (checks[k].name);
+
+		converged = solve_path (pr, rule, path);
+		diff = test_path_max_diff (ref, path);
+		sprintf (msg, "max diff from cyclic = %.3e%s", diff, (converged) ? "" : " (not converged)");
+		test_check (converged && diff < checks[k].max_diff, rule->name, msg);
+		test_path_free (path);
+	}
+
+	// row parallel is deterministic for the num of threads
+	check_deterministic (pr, find_rule ("row parallel"));
+
+	test_path_free (ref);
+	test_problem_free (pr);
+
+	return (test_num_failed () > 0) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,215 @@
+/*
+ * test_xmatfile.c
+ *
+ *  Check the round trip of X through the kernel matrix container
+ *  of each format of the columns, and that its header is read back
+ *  and the checksums of the tiles detect the corruption.
+ *
+ *  Created on: 2026/10/19
+ *      Author: utsugi
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <math.h>
+
+#include "testutil.h"
+
+/* container written in the current directory */
+#define XMATFILE_NAME	"test_xmatfile.xmat"
+
+/* format of the columns and the max error relative to max |X(:,j)| of a row block */
+typedef struct {
+	const char			*name;
+	MMRealXmatFormat	format;
+	double				max_err;
+} format_check;
+
+static const format_check	formats[] = {
+	{"float64", MM_REAL_XMAT_FLOAT64, 0.},
+	// rounding to 24 bits of the mantissa
+	{"float32", MM_REAL_XMAT_FLOAT32, 6.e-8},
+	// rounding to 1 / 32767 of the max, and the scale which is stored as float
+	{"int16", MM_REAL_XMAT_INT16, 1.6e-5}
+};
+
+/* return max_j max |X(i,j) - Y(i,j)| / max |X(:,j)| over the rows of each row block,
+ * where Y is read from the container through the provider */
+static double
+max_relative_error (const mm_dense *x, provider *p, const int rowblock)
+{
+	int			i, j;
+	double		err = 0.;
+	mm_dense	*yj = mm_real_new (MM_REAL_DENSE, MM_REAL_GENERAL, x->m, 1, x->m);
+
+	for (j = 0; j < x->n; j++) {
+		int		i0;
+		double	*xj = x->data + (size_t) j * x->m;
+		mm_real_set_all (yj, 0.);
+		provider_axjpy (1., p, j, yj);
+		for (i0 = 0; i0 < x->m; i0 += rowblock) {
+			int		i1 = (i0 + rowblock < x->m) ? i0 + rowblock : x->m;
+			double	amax = 0.;
+			double	emax = 0.;
+			for (i = i0; i < i1; i++) {
+				double	e = fabs (xj[i] - yj->data[i]);
+				if (amax < fabs (xj[i])) amax = fabs (xj[i]);
+				if (emax < e) emax = e;
+			}
+			if (amax > 0. && err < emax / amax) err = emax / amax;
+		}
+	}
+	mm_real_free (yj);
+	return err;
+}
+
+/* write X into the container of format and read it back */
+static void
+check_round_trip (const test_problem *pr, const format_check *f, const int rowblock)
+{
+	char		name[BUFSIZ];
+	char		msg[BUFSIZ];
+	double		err;
+	provider	*p;
+
+	test_write_xmatfile (pr, XMATFILE_NAME, f->format, 16, rowblock);
+	p = provider_new_xmatfile (XMATFILE_NAME, 0);
+	err = max_relative_error (pr->x, p, (rowblock > 0) ? rowblock : pr->x->m);
+	provider_free (p);
+	remove (XMATFILE_NAME);
+
+	sprintf (name, "%s%s", f->name, (rowblock > 0) ? " row blocks" : "");
+	sprintf (msg, "max relative error = %.3e", err);
+	test_check (err <= f->max_err, name, msg);
+	return;
+}
+
+/* return whether the header read from fn is h */
+static bool
+header_is_equal (const char *fn, const mm_real_xmatfile_header *h)
+{
+	int						j;
+	bool					equal;
+	FILE					*fp = fopen (fn, "rb");
+	mm_real_xmatfile_header	*h1 = mm_real_xmatfile_header_read (fp);
+
+	fclose (fp);
+	if (h1 == NULL) return false;
+	equal = (h1->format == h->format && h1->m == h->m && h1->n == h->n && h1->tile == h->tile
+		&& h1->rowblock == h->rowblock && h1->reclen == h->reclen && h1->offset == h->offset);
+	for (j = 0; equal && j < h->n; j++) equal = (h1->sx[j] == h->sx[j] && h1->xtx[j] == h->xtx[j]);
+	mm_real_xmatfile_header_free (h1);
+	return equal;
+}
+
+/* return whether the checksums of the tiles of fn match */
+static bool
+checksum_is_valid (const char *fn)
+{
+	bool					valid = false;
+	FILE					*fp = fopen (fn, "rb");
+	mm_real_xmatfile_header	*h = mm_real_xmatfile_header_read (fp);
+
+	if (h) {
+		valid = mm_real_xmatfile_verify (fp, h);
+		mm_real_xmatfile_header_free (h);
+	}
+	fclose (fp);
+	return valid;
+}
+
+/* flip a bit of the byte at offset of fn */
+static void
+flip_byte (const char *fn, const off_t offset)
+{
+	int		c;
+	FILE	*fp = fopen (fn, "r+b");
+	fseeko (fp, offset, SEEK_SET);
+	c = fgetc (fp);
+	fseeko (fp, offset, SEEK_SET);
+	fputc (c ^ 0x10, fp);
+	fclose (fp);
+	return;
+}
+
+/* the header is read back, and the checksums detect a flipped byte of the last tile
+ * and the truncated container */
+static void
+check_checksum (const test_problem *pr)
+{
+	int						j;
+	size_t					size;
+	off_t					last;
+	mm_real_xmatfile_header	*h = mm_real_xmatfile_header_new (MM_REAL_XMAT_FLOAT32, pr->x->m, pr->x->n, 16, 30, 0);
+
+	for (j = 0; j < pr->x->n; j++) {
+		h->sx[j] = pr->lreg->sx[j];
+		h->xtx[j] = pr->lreg->xtx[j];
+	}
+	test_write_xmatfile (pr, XMATFILE_NAME, h->format, h->tile, h->rowblock);
+	test_check (header_is_equal (XMATFILE_NAME, h), "header", "read back");
+	test_check (checksum_is_valid (XMATFILE_NAME), "checksum", "valid container is verified");
+
+	last = (off_t) mm_real_xmatfile_tile_offset (h, h->ntiles - 1);
+	flip_byte (XMATFILE_NAME, last + 5);
+	test_check (!checksum_is_valid (XMATFILE_NAME), "checksum", "flipped byte is detected");
+	flip_byte (XMATFILE_NAME, last + 5);
+	test_check (checksum_is_valid (XMATFILE_NAME), "checksum", "restored byte is verified");
+
+	size = mm_real_xmatfile_tile_offset (h, h->ntiles - 1)
+		+ (size_t) mm_real_xmatfile_tile_ncols (h, h->ntiles - 1) * h->reclen;
+	truncate (XMATFILE_NAME, (off_t) size - 1);
+	test_check (!checksum_is_valid (XMATFILE_NAME), "checksum", "truncated container is detected");
+
+	remove (XMATFILE_NAME);
+	mm_real_xmatfile_header_free (h);
+	return;
+}
+
+/* a column of X is larger than the size of a tile, and the rows are divided into row blocks,
+ * then a row block of a tile is the size, so a tile has several columns.
+ * The container of such tiles is verified and read back */
+static void
+check_tile_width (const test_problem *pr)
+{
+	int			rowblock = 10;
+	size_t		size = 4 * mm_real_xmatfile_record_size (MM_REAL_XMAT_FLOAT64, rowblock);
+	int			tile = mm_real_xmatfile_tile_width (MM_REAL_XMAT_FLOAT64, pr->x->m, rowblock, size);
+	char		msg[BUFSIZ];
+	double		err;
+	provider	*p;
+
+	sprintf (msg, "tile = %d for a column of %zu bytes and size = %zu", tile,
+		mm_real_xmatfile_record_size (MM_REAL_XMAT_FLOAT64, pr->x->m), size);
+	test_check (tile == 4 && mm_real_xmatfile_record_size (MM_REAL_XMAT_FLOAT64, pr->x->m) > size, "tile width", msg);
+	test_check (mm_real_xmatfile_tile_width (MM_REAL_XMAT_FLOAT64, pr->x->m, 0, size) == 1, "tile width", "not divided");
+
+	test_write_xmatfile (pr, XMATFILE_NAME, MM_REAL_XMAT_FLOAT64, tile, rowblock);
+	test_check (checksum_is_valid (XMATFILE_NAME), "tile width", "container is verified");
+	p = provider_new_xmatfile (XMATFILE_NAME, 0);
+	err = max_relative_error (pr->x, p, rowblock);
+	provider_free (p);
+	remove (XMATFILE_NAME);
+	sprintf (msg, "max relative error = %.3e", err);
+	test_check (err == 0., "tile width", msg);
+	return;
+}
+
+int
+main (void)
+{
+	int				k;
+	test_problem	*pr = test_problem_new (6, 5, 4, 80);
+
+	for (k = 0; k < sizeof (formats) / sizeof (format_check); k++) {
+		check_round_trip (pr, formats + k, 0);
+		// int16 is scaled for each row block
+		check_round_trip (pr, formats + k, 30);
+	}
+	check_checksum (pr);
+	check_tile_width (pr);
+	test_problem_free (pr);
+
+	return (test_num_failed () > 0) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,267 @@
+/*
+ * testutil.c
+ *
+ *  Created on: 2026/10/19
+ *      Author: utsugi
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "testutil.h"
+
+/* number of failed checks */
+static int	num_failed = 0;
+
+/* uniform random number in [-1, 1) of the linear congruential generator,
+ * so that the problems are the same on every platform */
+static double
+test_rand (unsigned long *state)
+{
+	*state = *state * 6364136223846793005UL + 1442695040888963407UL;
+	return (double) (*state >> 11) / (double) (1UL << 52) - 1.;
+}
+
+/*** create the problem of nx x ny x nz cells and m observations ***/
+test_problem *
+test_problem_new (const int nx, const int ny, const int nz, const int m)
+{
+	int				i, j;
+	int				n = nx * ny * nz;
+	unsigned long	state = 20261019UL;
+	test_problem	*pr = (test_problem *) malloc (sizeof (test_problem));
+
+	pr->nx = nx;
+	pr->ny = ny;
+	pr->nz = nz;
+
+	pr->x = mm_real_new (MM_REAL_DENSE, MM_REAL_GENERAL, m, n, m * n);
+	for (j = 0; j < m * n; j++) pr->x->data[j] = test_rand (&state);
+
+	// y = X * beta + noise, where beta has a few blocks of nonzeros
+	pr->y = mm_real_new (MM_REAL_DENSE, MM_REAL_GENERAL, m, 1, m);
+	mm_real_set_all (pr->y, 0.);
+	for (j = 0; j < n; j++) {
+		if (j % 7 == 0 || j % 11 == 0) {
+			double	betaj = 1. + test_rand (&state);
+			for (i = 0; i < m; i++) pr->y->data[i] += betaj * pr->x->data[i + (size_t) j * m];
+		}
+	}
+	for (i = 0; i < m; i++) pr->y->data[i] += 0.1 * test_rand (&state);
+
+	pr->pen = penalty_new_stencil (nx, ny, nz, 1., 1., 1., 1.);
+	pr->lreg = linregmodel_new_with_penalty (pr->y, pr->x, pr->pen, DO_NORMALIZING_X);
+	return pr;
+}
+
+/*** free the problem ***/
+void
+test_problem_free (test_problem *pr)
+{
+	if (pr) {
+		linregmodel_free (pr->lreg);
+		penalty_free (pr->pen);
+		mm_real_free (pr->x);
+		mm_real_free (pr->y);
+		free (pr);
+	}
+	return;
+}
+
+/*** create new cdescent object of alpha = 0.9 for the problem, as l1l2inv ***/
+cdescent *
+test_cdescent_new (const test_problem *pr, const double tol, const bool parallel)
+{
+	cdescent	*cd = cdescent_new (0.9, pr->lreg, tol, 1000000, parallel);
+	cdescent_not_use_intercept (cd);
+	return cd;
+}
+
+/* seed of the randomized rules */
+static unsigned int	seed = 1019;
+
+static void
+set_cyclic (cdescent *cd, const test_problem *pr)
+{
+	cdescent_set_cyclic (cd);
+	return;
+}
+
+static void
+set_stochastic (cdescent *cd, const test_problem *pr)
+{
+	cdescent_set_stochastic (cd, &seed);
+	return;
+}
+
+static void
+set_importance (cdescent *cd, const test_problem *pr)
+{
+	cdescent_set_stochastic (cd, &seed);
+	cdescent_set_importance_sampling (cd);
+	return;
+}
+
+static void
+set_row_parallel (cdescent *cd, const test_problem *pr)
+{
+	cdescent_set_row_parallel (cd);
+	return;
+}
+
+static void
+set_accelerated (cdescent *cd, const test_problem *pr)
+{
+	cdescent_set_accelerated (cd, &seed);
+	return;
+}
+
+static void
+set_greedy (cdescent *cd, const test_problem *pr)
+{
+	cdescent_set_greedy (cd, 0);
+	return;
+}
+
+static void
+set_block (cdescent *cd, const test_problem *pr)
+{
+	// a depth layer is a block, as l1l2inv -B
+	cdescent_set_block (cd, pr->nx * pr->ny);
+	return;
+}
+
+static void
+set_svrg (cdescent *cd, const test_problem *pr)
+{
+	cdescent_set_svrg (cd, 16, &seed);
+	return;
+}
+
+static void
+set_anderson (cdescent *cd, const test_problem *pr)
+{
+	cdescent_set_anderson (cd, 5);
+	return;
+}
+
+/*** solvers of the tests, the first one is the reference ***/
+const test_rule	test_rules[] = {
+	{"cyclic", false, set_cyclic},
+	{"cyclic parallel", true, set_cyclic},
+	{"stochastic", false, set_stochastic},
+	{"importance sampling", false, set_importance},
+	{"importance sampling parallel", true, set_importance},
+	{"row parallel", true, set_row_parallel},
+	{"accelerated", false, set_accelerated},
+	{"greedy", false, set_greedy},
+	{"block", false, set_block},
+	{"svrg", false, set_svrg},
+	{"anderson", false, set_anderson}
+};
+
+const int		test_num_rules = sizeof (test_rules) / sizeof (test_rule);
+
+/*** solve the problem for TEST_NLAMBDAS lambdas from lambda1_max downward,
+ * and store beta of each lambda into path[k] if path != NULL.
+ * Return whether all the lambdas are converged ***/
+bool
+test_solve_path (cdescent *cd, mm_dense **path)
+{
+	int		k;
+	bool	converged = true;
+	double	log10_lambda_max = log10 (cd->lreg->camax / cd->alpha1);
+
+	for (k = 0; k < TEST_NLAMBDAS; k++) {
+		cdescent_set_log10_lambda (cd, log10_lambda_max - (k + 1) * TEST_DLOG10_LAMBDA);
+		if (!cdescent_do_update_one_cycle (cd)) converged = false;
+		if (path) path[k] = mm_real_copy (cd->beta);
+	}
+	return converged;
+}
+
+/*** free the path stored by test_solve_path ***/
+void
+test_path_free (mm_dense **path)
+{
+	int		k;
+	for (k = 0; k < TEST_NLAMBDAS; k++) mm_real_free (path[k]);
+	return;
+}
+
+/*** return max | path1 - path2 | ***/
+double
+test_path_max_diff (mm_dense **path1, mm_dense **path2)
+{
+	int		j, k;
+	double	amax = 0.;
+	for (k = 0; k < TEST_NLAMBDAS; k++) {
+		for (j = 0; j < path1[k]->nnz; j++) {
+			double	d = fabs (path1[k]->data[j] - path2[k]->data[j]);
+			if (amax < d) amax = d;
+		}
+	}
+	return amax;
+}
+
+/*** write normalized X of the problem into the kernel matrix container fn of format,
+ * by tiles of tile columns whose rows are divided into row blocks of rowblock rows (see mmreal.h).
+ * The sum and squared norm of the columns before normalized are stored as l1l2inv_xmat does ***/
+void
+test_write_xmatfile (const test_problem *pr, const char *fn, const MMRealXmatFormat format,
+	const int tile, const int rowblock)
+{
+	int						j, t;
+	mm_dense				*x = pr->x;
+	FILE					*fp = fopen (fn, "wb");
+	mm_real_xmatfile_header	*h = mm_real_xmatfile_header_new (format, x->m, x->n, tile, rowblock, 0);
+
+	if (fp == NULL) {
+		fprintf (stderr, "ERROR: cannot open file %s.\n", fn);
+		exit (EXIT_FAILURE);
+	}
+	for (j = 0; j < x->n; j++) {
+		h->sx[j] = pr->lreg->sx[j];
+		h->xtx[j] = pr->lreg->xtx[j];
+	}
+	for (t = 0; t < h->ntiles; t++) {
+		int		b;
+		size_t	len = (size_t) mm_real_xmatfile_tile_ncols (h, t) * h->reclen;
+		char	*buf = (char *) malloc (len);
+		for (j = t * h->tile; j < t * h->tile + mm_real_xmatfile_tile_ncols (h, t); j++) {
+			for (b = 0; b < h->nrowblocks; b++)
+				mm_real_xmatfile_encode (format, mm_real_xmatfile_block_nrows (h, b),
+					x->data + (size_t) j * x->m + (size_t) b * h->rowblock, buf + mm_real_xmatfile_record_offset (h, j, b));
+		}
+		h->checksum[t] = MM_REAL_XMATFILE_HASH_INIT;
+		for (b = 0; b < h->nrowblocks; b++)
+			h->checksum[t] = mm_real_xmatfile_hash (buf + mm_real_xmatfile_record_offset (h, t * h->tile, b),
+				mm_real_xmatfile_block_size (h, t, b), h->checksum[t]);
+		if (fseeko (fp, (off_t) mm_real_xmatfile_tile_offset (h, t), SEEK_SET) != 0 || fwrite (buf, len, 1, fp) != 1) {
+			fprintf (stderr, "ERROR: failed to write file %s.\n", fn);
+			exit (EXIT_FAILURE);
+		}
+		free (buf);
+	}
+	mm_real_xmatfile_header_write (fp, h);
+	fclose (fp);
+	mm_real_xmatfile_header_free (h);
+	return;
+}
+
+/*** print the result of the check name, and count it if failed ***/
+void
+test_check (const bool cond, const char *name, const char *msg)
+{
+	fprintf (stderr, "%s: %s: %s\n", (cond) ? "PASS" : "FAIL", name, msg);
+	if (!cond) num_failed++;
+	return;
+}
+
+/*** return the number of failed checks ***/
+int
+test_num_failed (void)
+{
+	return num_failed;
+}
@@ -0,0 +1,60 @@
+/*
+ * testutil.h
+ *
+ *  Created on: 2026/10/19
+ *      Author: utsugi
+ */
+
+#ifndef TESTUTIL_H_
+#define TESTUTIL_H_
+
+#include <stdbool.h>
+#include <cdescent.h>
+
+/*** small problem of the regression tests.
+ * X is dense m x n of n = nx * ny * nz cells, y = X * beta + noise for a sparse beta,
+ * and D is the first-difference stencils on the cells (see penalty_new_stencil) ***/
+typedef struct s_test_problem	test_problem;
+
+struct s_test_problem {
+	int				nx;
+	int				ny;
+	int				nz;
+
+	mm_dense		*x;
+	mm_dense		*y;
+	penalty			*pen;
+	linregmodel		*lreg;
+};
+
+/* number of lambdas on the path of the tests, and the interval on the log10 scale */
+#define TEST_NLAMBDAS		8
+#define TEST_DLOG10_LAMBDA	0.2
+
+/*** solver of the tests: name and the function which sets the rule of cd ***/
+typedef struct s_test_rule	test_rule;
+
+struct s_test_rule {
+	const char		*name;
+	bool			parallel;
+	void			(*set) (cdescent *cd, const test_problem *pr);
+};
+
+extern const test_rule	test_rules[];
+extern const int		test_num_rules;
+
+test_problem	*test_problem_new (const int nx, const int ny, const int nz, const int m);
+void			test_problem_free (test_problem *pr);
+
+cdescent		*test_cdescent_new (const test_problem *pr, const double tol, const bool parallel);
+bool			test_solve_path (cdescent *cd, mm_dense **path);
+void			test_path_free (mm_dense **path);
+double			test_path_max_diff (mm_dense **path1, mm_dense **path2);
+
+void			test_write_xmatfile (const test_problem *pr, const char *fn, const MMRealXmatFormat format,
+					const int tile, const int rowblock);
+
+void			test_check (const bool cond, const char *name, const char *msg);
+int				test_num_failed (void);
+
+#endif /* TESTUTIL_H_ */
@@ -39,8 +39,24 @@ bool	output_weighted = false;
 bool	output_matrix = false;
 // use parallel CDA
 bool	parallel = false;
+// use row-partitioned parallel CDA
+bool	row_parallel = false;
+// place X, beta and mu on NUMA nodes of the threads which use them
+bool	numa_first_touch = false;
 // use stochastic CDA
 bool	stochastic = false;
+// select coordinates of stochastic CDA in proportion to their curvature
+bool	importance_sampling = false;
+// use accelerated randomized CDA
+bool	accelerated = false;
+// use greedy (Gauss-Southwell-Lipschitz) CDA
+bool	greedy_rule = false;
+// use block CDA over the cells of each depth layer
+bool	block_layer = false;
+// number of rows of a mini-batch of Prox-SVRG (0: not use)
+int		svrg_batch = 0;
+// number of sweeps between Anderson extrapolations (0: not use)
+int		anderson_k = 0;
 // verbose mode
 bool	verbose = false;
 
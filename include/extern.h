@@ -39,8 +39,24 @@ extern bool	output_weighted;
 extern bool	output_matrix;
 // use parallel CDA
 extern bool	parallel;
+// use row-partitioned parallel CDA
+extern bool	row_parallel;
+// place X, beta and mu on NUMA nodes of the threads which use them
+extern bool	numa_first_touch;
 // use stochastic CDA
 extern bool	stochastic;
+// select coordinates of stochastic CDA in proportion to their curvature
+extern bool	importance_sampling;
+// use accelerated randomized CDA
+extern bool	accelerated;
+// use greedy (Gauss-Southwell-Lipschitz) CDA
+extern bool	greedy_rule;
+// use block CDA over the cells of each depth layer
+extern bool	block_layer;
+// number of rows of a mini-batch of Prox-SVRG (0: not use)
+extern int	svrg_batch;
+// number of sweeps between Anderson extrapolations (0: not use)
+extern int	anderson_k;
 // stretching the grid on the edge of the model space
 extern bool	stretching_grid;
 // verbose mode
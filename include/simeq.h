@@ -4,7 +4,7 @@
 typedef struct {
 	mm_dense	*y;
 	mm_dense	*x;
-	mm_sparse	*d;
+	penalty		*d;
 } simeq;
 
 enum {
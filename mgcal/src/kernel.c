@@ -52,7 +52,6 @@ kernel_matrix_set (double *a, const data_array *array, const grid *g, const vect
 {
 	int		m;
 	int		nx;
-	int		ny;
 	int		nz;
 	int		nh;
 
@@ -60,14 +59,16 @@ kernel_matrix_set (double *a, const data_array *array, const grid *g, const vect
 
 	m = array->n;
 	nx = g->nx;
-	ny = g->ny;
 	nz = g->nz;
 	nh = g->nh;
 
-#pragma omp parallel
+	/* columns are distributed to the threads in contiguous blocks by the static schedule,
+	 * so if the pages of a were first touched with the same partition,
+	 * each thread writes the columns placed on its own NUMA node */
+#pragma omp parallel proc_bind(spread)
 	{
-		int			i, j, k, l;
-		double		*z1 = NULL;
+		int			col, l;
+		int			n = nz * nh;
 		vector3d	*obs = vector3d_new (0., 0., 0.);
 		source		*src = source_new (0., 0.);
 		if (exf) src->exf = vector3d_copy (exf);
@@ -76,38 +77,26 @@ kernel_matrix_set (double *a, const data_array *array, const grid *g, const vect
 		src->begin->dim = vector3d_new (0., 0., 0.);
 		if (mgz) src->begin->mgz = vector3d_copy (mgz);
 
-#pragma omp for
-		for (k = 0; k < nz; k++) {
-			double	*zk = g->z + k;	// for parallel calculation
-			double	*dzk = g->dz + k;	// for parallel calculation
-			double	*yj = g->y;
-			double	*dyj = g->dy;
-			for (j = 0; j < ny; j++) {
-				double	*xi = g->x;
-				double	*dxi = g->dx;
-				if (g->z1) z1 = g->z1 + j * nx;
-				for (i = 0; i < nx; i++) {
-					double	*al = a + (k * nh + j * nx + i) * m;
-					double	*xl = array->x;
-					double	*yl = array->y;
-					double	*zl = array->z;
-					double	z1k = *zk;
-					if (z1) z1k += z1[i];
-					vector3d_set (src->begin->pos, *xi, *yj, z1k);
-					vector3d_set (src->begin->dim, *dxi, *dyj, *dzk);
-					for (l = 0; l < m; l++) {
-						vector3d_set (obs, *xl, *yl, *zl);
-						*al = f->function (obs, src, f->parameter);
-						al++;
-						xl++;
-						yl++;
-						zl++;
-					}
-					xi++;
-					dxi++;
-				}
-				yj++;
-				dyj++;
+#pragma omp for schedule(static)
+		for (col = 0; col < n; col++) {
+			int		k = col / nh;
+			int		j = (col % nh) / nx;
+			int		i = col % nx;
+			double	*al = a + (size_t) col * m;
+			double	*xl = array->x;
+			double	*yl = array->y;
+			double	*zl = array->z;
+			double	z1k = g->z[k];
+			if (g->z1) z1k += g->z1[j * nx + i];
+			vector3d_set (src->begin->pos, g->x[i], g->y[j], z1k);
+			vector3d_set (src->begin->dim, g->dx[i], g->dy[j], g->dz[k]);
+			for (l = 0; l < m; l++) {
+				vector3d_set (obs, *xl, *yl, *zl);
+				*al = f->function (obs, src, f->parameter);
+				al++;
+				xl++;
+				yl++;
+				zl++;
 			}
 		}
 		vector3d_free (obs);
@@ -141,7 +130,7 @@ kernel_matrix_scattered_set (double *a, const data_array *array, const scattered
 	m = array->n;
 	n = g->n;
 
-#pragma omp parallel
+#pragma omp parallel proc_bind(spread)
 	{
 		int			i, j;
 		vector3d	*obs = vector3d_new (0., 0., 0.);
@@ -152,7 +141,7 @@ kernel_matrix_scattered_set (double *a, const data_array *array, const scattered
 		src->begin->dim = vector3d_new (1., 1., 1.);
 		if (mgz) src->begin->mgz = vector3d_copy (mgz);
 
-#pragma omp for
+#pragma omp for schedule(static)
 		for (j = 0; j < n; j++) {
 			vector3d_set (src->begin->pos, g->x[j], g->y[j], g->z[j]);
 			if (g->dx && g->dy && g->dz) vector3d_set (src->begin->dim, g->dx[j], g->dy[j], g->dz[j]);
@@ -0,0 +1,88 @@
+#!/usr/bin/env bash
+
+
+#### function definitions ####
+
+# display usage and exit
+usage_exit() {
+	echo ""
+	echo "PROGAM: ${0##*/}"
+	echo ""
+	echo "DESGRIPTION:"
+	echo "       This script compares the coordinate selection rules of CDA"
+	echo "       (cyclic, stochastic, accelerated randomized, greedy and block)"
+	echo "       by calling \"l1l2inv\" with the same settings,"
+	echo "       and reports the total number of iterations and the elapsed time"
+	echo ""
+	echo "USAGE: ${0##*/}"
+	echo "       -a <alpha>"
+	echo "[optional]"
+	echo "       -w <lambda_min:dlambda; default is -1:0.1>"
+	echo "       -r <regression type: 0=L1,1=L1L2,2=L1TSV,3=L1L2TSV;"
+	echo "          default is 1=L1L2>"
+	echo "       -d <wx:wy:wz(L1TSV) or w0:wx:wy:wz(L1L2TSV)>"
+	echo "       -t <tolerance; default=1.e-5>"
+	echo "       -n <bounds of solution lower:upper; default is no bounds>"
+	echo "       -s <parameter settings file; default is ./settings>"
+	echo "       -h (show this message and exit)"
+	exit 1
+}
+
+dir=`dirname ${BASH_SOURCE}`
+
+RANGE="-1:0.1"
+TOL=1.e-5
+SFILE="./settings"
+TYPE=1 # L1L2
+
+while getopts "r:d:a:w:t:n:s:h" OPT; do
+	case "$OPT" in
+		r)  TYPE=$OPTARG ;;
+		d)  WEIGHTS=$OPTARG ;;
+		a)  ALPHA=$OPTARG ;;
+		w)  RANGE=$OPTARG ;;
+		t)  TOL=$OPTARG ;;
+		n)  BOUNDS=$OPTARG ;;
+		s)  SFILE=$OPTARG ;;
+		h)  usage_exit ;;
+		/?) usage_exit ;;
+	esac
+done
+
+if [ -z $ALPHA ]; then
+	echo "ERROR: please specify alpha as -a <alpha>"
+	usage_exit
+fi
+
+if [ ! -e "$dir"/l1l2inv ]; then
+	echo "ERROR: ${0##*/}: inversion program \"l1l2inv\" is not found"
+	echo "in the directory where this script exists."
+	exit 1
+fi
+
+OPTS=""
+if [ ! -z "$WEIGHTS" ]; then
+	OPTS="-d $WEIGHTS $OPTS"
+fi
+if [ ! -z "$BOUNDS" ]; then
+	OPTS="-n $BOUNDS $OPTS"
+fi
+
+# rule name and option of l1l2inv
+RULES="cyclic: stochastic:-c accelerated:-A greedy:-G block:-B"
+
+printf "# %-12s %12s %12s\n" "rule" "total_iter" "time[sec]"
+for rule in $RULES; do
+	name=${rule%%:*}
+	opt=${rule#*:}
+	log=`"$dir"/l1l2inv -a $ALPHA -r $TYPE -w "$RANGE" -t $TOL -s $SFILE ${OPTS} $opt 2>&1 >/dev/null`
+	if [ $? -ne 0 ]; then
+		echo "ERROR: program \"l1l2inv\" did not finish successfully. script abort!"
+		exit 1
+	fi
+	iter=`echo "$log" | sed -n 's/^total num of iter = //p'`
+	elapsed=`echo "$log" | sed -n 's/^elapsed time = \([0-9.]*\) sec/\1/p'`
+	printf "  %-12s %12s %12s\n" $name $iter $elapsed
+	mv beta_path.data beta_path_$name.data
+	mv regression_info.data regression_info_$name.data
+done
@@ -33,9 +33,23 @@ usage_exit() {
 	echo "       -g <0(false) or 1(true): stretch the grid cells"
 	echo "           at the edge of the model space outward, default is 1>"
 	echo "       -p (perform CDA using parallel computing; default is none)"
+	echo "       -P (perform CDA parallelizing each update over observations;"
+	echo "           default is none)"
+	echo "       -N (with -p or -P, place the matrix on NUMA nodes"
+	echo "           of the threads which use it; default is none)"
 	echo "       -q (perform second-step inversion using most opt-lambda;"
 	echo "           default is none)"
 	echo "       -c (use stochastic CDA instead of cyclic CDA; default is none)"
+	echo "       -I (with -c, select coordinates in proportion to their curvature;"
+	echo "           default is none)"
+	echo "       -A (use accelerated randomized CDA instead of cyclic CDA;"
+	echo "           default is none)"
+	echo "       -G (use greedy CDA instead of cyclic CDA; default is none)"
+	echo "       -B (use block CDA over the cells of each depth layer; default is none)"
+	echo "       -S <B: use Prox-SVRG over mini-batches of B rows instead of CDA;"
+	echo "           default is none>"
+	echo "       -e <K: extrapolate iterates of every K sweeps of CDA"
+	echo "           by Anderson acceleration, K >= 2; default is none>"
 	echo "       -v (verbose mode)"
 	echo "       -h (show this message and exit)"
 	exit 1
@@ -61,10 +75,42 @@ setopts() {
 		OPTS="$OPTS -c"
 	fi
 
+	if [ ! -z "$SVRG" ]; then
+		OPTS="$OPTS -S $SVRG"
+	fi
+
+	if [ ! -z "$ANDERSON" ]; then
+		OPTS="$OPTS -e $ANDERSON"
+	fi
+
+	if [ ! -z $GREEDY ]; then
+		OPTS="$OPTS -G"
+	fi
+
+	if [ ! -z $BLOCK ]; then
+		OPTS="$OPTS -B"
+	fi
+
+	if [ ! -z $ACCELERATED ]; then
+		OPTS="$OPTS -A"
+	fi
+
+	if [ ! -z $IMPORTANCE ]; then
+		OPTS="$OPTS -I"
+	fi
+
 	if [ ! -z $PARALLEL ]; then
 		OPTS="$OPTS -p"
 	fi
 
+	if [ ! -z $ROWPARALLEL ]; then
+		OPTS="$OPTS -P"
+	fi
+
+	if [ ! -z $NUMA ]; then
+		OPTS="$OPTS -N"
+	fi
+
 	if [ ! -z $OUTPUT_VECTORS ]; then
 		OPTS="$OPTS -o"
 	fi
@@ -101,7 +147,7 @@ SFILE="./settings"
 BETA=0.01
 TYPE=1 # L1L2
 
-while getopts "r:d:a:w:t:n:s:b:g:kpqcouvh" OPT; do
+while getopts "r:d:a:w:t:n:s:b:g:e:S:kpPNqcIAGBouvh" OPT; do
 	case "$OPT" in
 		r)  TYPE=$OPTARG ;;
 		d)  WEIGHTS=$OPTARG ;;
@@ -114,8 +160,16 @@ while getopts "r:d:a:w:t:n:s:b:g:kpqcouvh" OPT; do
 		b)  BETA=$OPTARG ;;
 		g)  GRID=$OPTARG ;;
 		p)  PARALLEL=1 ;;
+		P)  ROWPARALLEL=1 ;;
+		N)  NUMA=1 ;;
 		q)  SPLINE=1 ;;
 		c)  STOCHASTIC=1 ;;
+		I)  IMPORTANCE=1 ;;
+		A)  ACCELERATED=1 ;;
+		G)  GREEDY=1 ;;
+		B)  BLOCK=1 ;;
+		e)  ANDERSON=$OPTARG ;;
+		S)  SVRG=$OPTARG ;;
 		o)  OUTPUT_VECTORS=1 ;;
 		u)  OUTPUT_WEIGHTED=1 ;;
 		v)  VERBOSE=1 ;;
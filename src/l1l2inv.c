@@ -13,6 +13,7 @@
 #include "utils.h"
 #include "settings.h"
 #include "extern.h"
+#include "extern_consts.h"
 
 int
 num_separator (char *str, const char c)
@@ -28,19 +29,6 @@ num_separator (char *str, const char c)
 	return n;
 }
 
-bool
-l1l2inv_constraint_func (cdescent *cd, const int j, const double etaj, double *val)
-{
-	double	scale = 1.;
-	if (cd->lreg->xnormalized) scale = sqrt (cd->lreg->xtx[j]);
-
-	*val = lower * scale;
-	if (cd->beta->data[j] + etaj < *val) return false;
-	*val = upper * scale;
-	if (cd->beta->data[j] + etaj > *val) return false;
-	return true;
-}
-
 static void
 fprintf_vectors (linregmodel *lreg)
 {
@@ -68,9 +56,10 @@ l1l2inv (simeq *eq, char *path_fn, char *info_fn)
 {
 	linregmodel	*lreg;
 	cdescent	*cd;
+	struct timespec	t0, t1;
 
 	if (verbose) fprintf (stderr, "preparing linregmodel object... ");
-	lreg = linregmodel_new (eq->y, eq->x, eq->d, DO_NORMALIZING_X);
+	lreg = linregmodel_new_with_penalty (eq->y, eq->x, eq->d, DO_NORMALIZING_X);
 	if (verbose) fprintf (stderr, "done\n");
 	if (output_vector) fprintf_vectors (lreg);
 
@@ -91,10 +80,26 @@ l1l2inv (simeq *eq, char *path_fn, char *info_fn)
 	if (stochastic) {
 		time_t	t = time (NULL);
 		cdescent_set_stochastic (cd, (unsigned int *) &t);
+		if (importance_sampling) cdescent_set_importance_sampling (cd);
 	}
+	if (accelerated) {
+		time_t	t = time (NULL);
+		cdescent_set_accelerated (cd, (unsigned int *) &t);
+	}
+	if (greedy_rule) cdescent_set_greedy (cd, 0);
+	// columns of X of a depth layer, i.e. nx * ny cells, are consecutive
+	if (block_layer) cdescent_set_block (cd, ngrd[0] * ngrd[1]);
+	if (svrg_batch > 0) {
+		time_t	t = time (NULL);
+		cdescent_set_svrg (cd, svrg_batch, (unsigned int *) &t);
+	}
+
+	if (anderson_k > 0) cdescent_set_anderson (cd, anderson_k);
+	if (row_parallel) cdescent_set_row_parallel (cd);
+	if (numa_first_touch) cdescent_use_first_touch (cd);
 
 	cdescent_not_use_intercept (cd);
-	if (constraint) cdescent_set_constraint (cd, l1l2inv_constraint_func);
+	if (constraint) cdescent_set_box_constraint (cd, lower, upper);
 	if (output_weighted) cd->output_rescaled = false;
 	if (verbose) cd->verbose = true;
 
@@ -105,8 +110,11 @@ l1l2inv (simeq *eq, char *path_fn, char *info_fn)
 	if (use_log10_lambda_upper) cdescent_set_log10_lambda_upper (cd, log10_lambda_upper);
 
 	fprintf (stderr, "regression start\n");
+	clock_gettime (CLOCK_MONOTONIC, &t0);
 	if (!cdescent_do_pathwise_optimization (cd)) fprintf (stderr, "not converged.\n");
+	clock_gettime (CLOCK_MONOTONIC, &t1);
 	fprintf (stderr, "total num of iter = %d\n", cd->total_iter);
+	fprintf (stderr, "elapsed time = %.3f sec\n", (double) (t1.tv_sec - t0.tv_sec) + 1.e-9 * (double) (t1.tv_nsec - t0.tv_nsec));
 	if (cd->use_intercept) fprintf (stderr, "intercept = %.4e\n", cd->b0);
 
 	cdescent_free (cd);
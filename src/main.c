@@ -48,7 +48,27 @@ usage (char *toolname)
 	fprintf (stderr, "           at the edge of the model space outward,\n");
 	fprintf (stderr, "           default is 1]\n");
 	fprintf (stderr, "       -p (use parallel CDA: default is not use)\n");
+	fprintf (stderr, "       -P (use row-partitioned parallel CDA:\n");
+	fprintf (stderr, "           each coordinate update is parallelized over\n");
+	fprintf (stderr, "           observations, default is not use)\n");
+	fprintf (stderr, "       -N (with -p or -P, place X on NUMA nodes of the threads\n");
+	fprintf (stderr, "           which use them by first touch, default is not use)\n");
 	fprintf (stderr, "       -c (use stochastic CDA: default is not use)\n");
+	fprintf (stderr, "       -I (with -c, select coordinates in proportion to\n");
+	fprintf (stderr, "           X(:,j)'*X(:,j) + lambda2*D(:,j)'*D(:,j): default is not use)\n");
+	fprintf (stderr, "       -A (use accelerated randomized CDA (APPROX), which helps\n");
+	fprintf (stderr, "           when lambda2 is small, e.g. alpha close to 1 or L1,\n");
+	fprintf (stderr, "           but is slower than -c if lambda2 is large, e.g. alpha=0.9:\n");
+	fprintf (stderr, "           default is not use, -p and -P are ignored)\n");
+	fprintf (stderr, "       -G (use greedy CDA (Gauss-Southwell-Lipschitz rule):\n");
+	fprintf (stderr, "           default is not use, -p and -P are ignored)\n");
+	fprintf (stderr, "       -B (use block CDA over the cells of each depth layer:\n");
+	fprintf (stderr, "           default is not use, -p and -P are ignored)\n");
+	fprintf (stderr, "       -S [B: use Prox-SVRG over mini-batches of B rows\n");
+	fprintf (stderr, "           instead of CDA, converged if relative decrease of objective < tol^2:\n");
+	fprintf (stderr, "           default is not use, -p and -P are ignored]\n");
+	fprintf (stderr, "       -e [K: extrapolate iterates of every K sweeps\n");
+	fprintf (stderr, "           by Anderson acceleration, K >= 2: default is not use]\n");
 	fprintf (stderr, "       -o (output y and xtx to y.data and xtx.data)\n");
 	fprintf (stderr, "       -v (verbose mode)\n");
 	fprintf (stderr, "       -h (show this message)\n\n");
@@ -72,7 +92,7 @@ read_input_params (int argc, char **argv)
 	char	c;
 
 	stretch_grid_at_edge = true;
-	while ((c = getopt (argc, argv, ":r:d:a:w:t:m:n:s:b:g:kpcouvh")) != EOF) {
+	while ((c = getopt (argc, argv, ":r:d:a:w:t:m:n:s:b:g:e:S:kpPNcIAGBouvh")) != EOF) {
 		switch (c) {
 
 			case 'r':
@@ -154,10 +174,42 @@ read_input_params (int argc, char **argv)
 				parallel = true;
 				break;
 
+			case 'P':
+				row_parallel = true;
+				break;
+
+			case 'N':
+				numa_first_touch = true;
+				break;
+
 			case 'c':
 				stochastic = true;
 				break;
 
+			case 'I':
+				importance_sampling = true;
+				break;
+
+			case 'A':
+				accelerated = true;
+				break;
+
+			case 'G':
+				greedy_rule = true;
+				break;
+
+			case 'B':
+				block_layer = true;
+				break;
+
+			case 'e':
+				anderson_k = atoi (optarg);
+				break;
+
+			case 'S':
+				svrg_batch = atoi (optarg);
+				break;
+
 			case 'o':
 				output_vector = true;
 				break;
@@ -201,12 +253,12 @@ read_input_params (int argc, char **argv)
 }
 
 static void
-weight_d (mm_real *x, mm_real *d)
+weight_d (mm_real *x, penalty *d)
 {
 	int		j;
 	for (j = 0; j < x->n; j++) {
 		double	wj = mm_real_xj_nrm2 (x, j);
-		mm_real_xj_scale (d, j, 1. / wj);
+		penalty_scale_column (d, j, 1. / wj);
 	}
 	return;
 }
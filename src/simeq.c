@@ -6,9 +6,11 @@
 #include <mgcal.h>
 #include <cdescent.h>
 
-#include "smooth.h"
 #include "simeq.h"
 
+extern bool	numa_first_touch;
+extern bool	row_parallel;
+
 simeq *
 simeq_new (void)
 {
@@ -25,7 +27,7 @@ simeq_free (simeq *eq)
 	if (eq) {
 		if (eq->x) mm_real_free (eq->x);
 		if (eq->y) mm_real_free (eq->y);
-		if (eq->d) mm_real_free (eq->d);
+		if (eq->d) penalty_free (eq->d);
 	}
 	return;
 }
@@ -108,6 +110,11 @@ create_kernel_matrix_dense (const double exf_inc, const double exf_dec,
 	vector3d	*mag;
 	mm_dense	*a = mm_real_new (MM_REAL_DENSE, MM_REAL_GENERAL, m, n, nnz);
 
+	/* pages of a are placed by the threads which own the columns in parallel CDA,
+	 * or the row slices of all columns in row-parallel CDA (-P),
+	 * as beta and mu are placed by cdescent_use_first_touch */
+	if (numa_first_touch) mm_real_first_touch (a, row_parallel, 0.);
+
 	exf = vector3d_new_with_geodesic_poler (1., exf_inc, exf_dec);
 	mag = vector3d_new_with_geodesic_poler (1., mag_inc, mag_dec);
 	kernel_matrix_set (a->data, array, gsrc, mag, exf, func);
@@ -193,15 +200,18 @@ create_simeq (const int type, const double exf_inc, const double exf_dec,
 
 	eq->x = create_kernel_matrix_dense (exf_inc, exf_dec, mag_inc, mag_dec, array, gsrc, func);
 
+	/* D is not stored, see mm_real_smooth_1 and mm_real_smooth_l01_1 of smooth.c for its structure */
 	switch (type) {
 		case TYPE_L1L2:
-			eq->d = mm_real_eye (MM_REAL_SPARSE, eq->x->n);
+			eq->d = penalty_new_identity (eq->x->n, 1.);
 			break;
 		case TYPE_L1TSV:
-			eq->d = mm_real_smooth_1 (MM_REAL_SPARSE, gsrc->nx, gsrc->ny, gsrc->nz, w);
+			if (w) eq->d = penalty_new_stencil (gsrc->nx, gsrc->ny, gsrc->nz, 0., w[0], w[1], w[2]);
+			else eq->d = penalty_new_stencil (gsrc->nx, gsrc->ny, gsrc->nz, 0., 1., 1., 1.);
 			break;
 		case TYPE_L1L2TSV:
-			eq->d = mm_real_smooth_l01_1 (MM_REAL_SPARSE, gsrc->nx, gsrc->ny, gsrc->nz, w);
+			if (w) eq->d = penalty_new_stencil (gsrc->nx, gsrc->ny, gsrc->nz, w[0], w[1], w[2], w[3]);
+			else eq->d = penalty_new_stencil (gsrc->nx, gsrc->ny, gsrc->nz, 1., 1., 1., 1.);
 			break;
 		default:
 			break;
@@ -1,14 +0,0 @@
-/*
- * io.h
- *
- *  Created on: 2016/07/16
- *      Author: utsugi
- */
-
-#ifndef IO_H_
-#define IO_H_
-
-void	fprintf_weighted_solutionpath (FILE *stream, cdescent *cd);
-void	fprintf_solutionpath (FILE *stream, cdescent *cd);
-
-#endif /* IO_H_ */
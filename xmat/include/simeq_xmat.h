@@ -1,9 +1,26 @@
 #ifndef _SIMEQ_H_
 #define _SIMEQ_H_
 
+/* kernel matrix container which stores the columns of X */
+#define XMATFILE_NAME	"xmat.dat"
+
+/* kernel function which calculates the columns of X on the fly,
+ * instead of storing them in XMATFILE_NAME (see kernel_column) */
+typedef struct {
+	int					m;
+	int					n;
+	double				*obs;		// observation points (x, y, z): size 3 * m
+	double				*cell;		// center and dimension of the grid cells: size 6 * n
+	vector3d			*exf;		// direction of the external field
+	vector3d			*mag;		// direction of the magnetization
+	mgcal_theoretical	function;
+	void				*parameter;
+} kernel;
+
 typedef struct {
 	mm_dense	*y;
-	mm_sparse	*d;
+	penalty		*d;
+	kernel		*k;		// kernel which calculates X on the fly, or NULL if X is stored in XMATFILE_NAME
 } simeq;
 
 enum {
@@ -14,6 +31,13 @@ enum {
 	TYPE_L1L2TSV = 3
 };
 
+kernel	*kernel_new (const double exf_inc, const double exf_dec,
+			const double mag_inc, const double mag_dec,
+			const data_array *array, const grid *gsrc, const mgcal_func *func);
+void	kernel_free (kernel *k);
+void	kernel_column (const int j, double *xj, void *data);
+double	*kernel_xtx (const kernel *k);
+
 simeq	*simeq_new (void);
 void	simeq_free (simeq *eq);
 void	simeq_centering_y (simeq *eq);
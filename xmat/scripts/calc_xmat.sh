@@ -3,16 +3,6 @@
 
 #### function definitions ####
 
-# display warning for use of -p option
-warning_parallelCDA() {
-	echo "WARNING: When -p option (enable parallel CDA) is specified"
-	echo "         to l1l2inv_xmat, performance of inversion is"
-	echo "         likely to gets worse. So, -p option is ignored."
-	echo "         If you want to use parallel CDA forcibly,"
-	echo "         use -force-parallelCDA option."
-	return
-}
-
 # display usage and exit
 usage_exit() {
 	echo ""
@@ -43,14 +33,21 @@ usage_exit() {
 	echo "          this option is ignored"
 	echo "       -g <0(false) or 1(true): stretch the grid cells"
 	echo "           at the edge of the model space outward, default is 1>"
-	echo "       -x (not create new xmat files, instead, use already existings.)"
+	echo "       -x (not create new xmat file, instead, use already existing one"
+	echo "           if it was created with the same settings and is not corrupted.)"
+	echo "       -F <format of xmat file: 0=float64, 1=float32, 2=int16;"
+	echo "           default is 0>"
+	echo "       -T <size in MB of a tile of columns in xmat file; default is 4>"
+	echo "       -B <num of rows of a row block in xmat file, and use block CDA"
+	echo "           over the tiles; default is not divided>"
 	echo "       -q (perform second-step inversion using most opt-lambda;"
 	echo "           default is none)"
 	echo "       -c (use stochastic CDA instead of cyclic CDA; default is none)"
+	echo "       -p (use parallel CDA; default is none)"
 	echo "       -v (verbose mode)"
 	echo "       -h (show this message and exit)"
 	echo ""
-	echo "       --force-parallelCDA (force to use parallel CDA; default is none)"
+	echo "       --force-parallelCDA (same as -p, for compatibility)"
 	echo ""
 	exit 1
 }
@@ -75,6 +72,18 @@ setopts() {
 		OPTS="$OPTS -x"
 	fi
 
+	if [ ! -z $XMATFORMAT ]; then
+		OPTS="$OPTS -F $XMATFORMAT"
+	fi
+
+	if [ ! -z $XMATTILE ]; then
+		OPTS="$OPTS -T $XMATTILE"
+	fi
+
+	if [ ! -z $XMATROWBLOCK ]; then
+		OPTS="$OPTS -B $XMATROWBLOCK"
+	fi
+
 	if [ ! -z $STOCHASTIC ]; then
 		OPTS="$OPTS -c"
 	fi
@@ -115,7 +124,7 @@ SFILE="./settings"
 BETA=0.01
 TYPE=1 # L1L2
 
-while getopts "r:d:a:w:t:n:s:b:g:-:kxpqcuvh" OPT; do
+while getopts "r:d:a:w:t:n:s:b:g:F:T:B:-:kxpqcuvh" OPT; do
 	case "$OPT" in
 		r) TYPE=$OPTARG ;;
 		d)  WEIGHTS=$OPTARG ;;
@@ -128,7 +137,10 @@ while getopts "r:d:a:w:t:n:s:b:g:-:kxpqcuvh" OPT; do
 		b)  BETA=$OPTARG ;;
 		g)  GRID=$OPTARG ;;
 		x)  USEXMAT=1 ;;
-		p)  warning_parallelCDA ;;
+		F)  XMATFORMAT=$OPTARG ;;
+		T)  XMATTILE=$OPTARG ;;
+		B)  XMATROWBLOCK=$OPTARG ;;
+		p)  PARALLEL=1 ;;
 		q)  SPLINE=1 ;;
 		c)  STOCHASTIC=1 ;;
 		u)  OUTPUT_WEIGHTED=1 ;;
@@ -136,7 +148,6 @@ while getopts "r:d:a:w:t:n:s:b:g:-:kxpqcuvh" OPT; do
 		h)  usage_exit ;;
         -)  case "${OPTARG}" in
             	force-parallelCDA)
-            		echo "force to use parallelCDA"
             		PARALLEL=1
             		;;
             esac ;;
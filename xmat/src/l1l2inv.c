@@ -16,8 +16,17 @@
 #include "extern_consts.h"
 
 extern bool	create_xmat;
-int			num_xfiles;
-int			xfile_len;
+extern int	xj_pool_mb;
+extern bool	xj_pool_mmap;
+extern int	xj_read_ahead;
+// format of columns of X stored in the container, the format of the existing container is used with -x
+MMRealXmatFormat	xfile_format = MM_REAL_XMAT_FLOAT64;
+// size of a tile of columns of X in the container in MB
+int					xfile_tile_mb = 4;
+// num of rows of a row block of X in the container, 0 if the rows are not divided
+int					xfile_rowblock = 0;
+// columns of X are calculated by the kernel function on the fly instead of stored in the container
+bool				xfile_on_the_fly = false;
 
 int
 num_separator (char *str, const char c)
@@ -33,19 +42,6 @@ num_separator (char *str, const char c)
 	return n;
 }
 
-bool
-l1l2inv_constraint_func (cdescent *cd, const int j, const double etaj, double *val)
-{
-	double	scale = 1.;
-	if (cd->lreg->xnormalized) scale = sqrt (cd->lreg->xtx[j]);
-
-	*val = lower * scale;
-	if (cd->beta->data[j] + etaj < *val) return false;
-	*val = upper * scale;
-	if (cd->beta->data[j] + etaj > *val) return false;
-	return true;
-}
-
 static void
 fprintf_vectors (linregmodel *lreg)
 {
@@ -54,14 +50,14 @@ fprintf_vectors (linregmodel *lreg)
 	fp = fopen ("y.data", "w");
 	if (fp) {
 		int		i;
-		for (i = 0; i < lreg->m; i++) fprintf (fp, "%f\n", lreg->y->data[i]);
+		for (i = 0; i < lreg->y->m; i++) fprintf (fp, "%f\n", lreg->y->data[i]);
 		fclose (fp);
 	}
 
 	fp = fopen ("xtx.data", "w");
 	if (fp) {
 		int		j;
-		for (j = 0; j < lreg->n; j++) fprintf (fp, "%f\n", lreg->xtx[j]);
+		for (j = 0; j < lreg->prov->n; j++) fprintf (fp, "%f\n", lreg->xtx[j]);
 		fclose (fp);
 	}
 
@@ -71,17 +67,19 @@ fprintf_vectors (linregmodel *lreg)
 bool
 l1l2inv (simeq *eq, char *path_fn, char *info_fn)
 {
-	int					m, n;
+	provider			*prov;
 	linregmodel			*lreg;
 	cdescent			*cd;
 
-	m = eq->y->m;
-	n = ngrd[0] * ngrd[1] * ngrd[2];
-	num_xfiles = ngrd[2];
-	xfile_len = ngrd[0] * ngrd[1];
-
 	if (verbose) fprintf (stderr, "preparing linregmodel object... ");
-	lreg = linregmodel_new (m, n, num_xfiles, eq->y, eq->d);
+	if (eq->k) prov = provider_new_function (eq->k->m, eq->k->n, kernel_column, eq->k, (size_t) xj_pool_mb << 20);
+	else if (xj_pool_mmap) prov = provider_new_xmatfile_mmap (XMATFILE_NAME);
+	else prov = provider_new_xmatfile (XMATFILE_NAME, (size_t) xj_pool_mb << 20);
+	// columns in the container are already normalized, and the calculated columns are normalized here
+	lreg = linregmodel_new_with_provider (eq->y, prov, eq->d, (eq->k) ? DO_NORMALIZING_X : DO_NOTHING);
+	// columns are visited in order only in cyclic CDA.
+	// Read ahead is started after the columns are normalized, so it does not load them in parallel with that
+	if (xj_read_ahead > 0 && !stochastic) provider_read_ahead (prov, xj_read_ahead);
 
 	if (verbose) fprintf (stderr, "done\n");
 	if (output_vector) fprintf_vectors (lreg);
@@ -98,15 +96,17 @@ l1l2inv (simeq *eq, char *path_fn, char *info_fn)
 		}
 	}
 	if (verbose) fprintf (stderr, "done\n");
-	fprintf (stderr, "[m, n] = [%d, %d]\n", cd->lreg->m, cd->lreg->n);
+	fprintf (stderr, "[m, n] = [%d, %d]\n", *cd->m, *cd->n);
 
-	if (stochastic) {
+	// X divided into row blocks is updated by the blocks of the columns of its tiles
+	if (provider_has_blocks (lreg->prov) && lreg->prov->rowblock < lreg->prov->m) cdescent_set_block (cd, lreg->prov->tile);
+	else if (stochastic) {
 		time_t	t = time (NULL);
 		cdescent_set_stochastic (cd, (unsigned int *) &t);
 	}
 
 	cdescent_not_use_intercept (cd);
-	if (constraint) cdescent_set_constraint (cd, l1l2inv_constraint_func);
+	if (constraint) cdescent_set_box_constraint (cd, lower, upper);
 	if (output_weighted) cd->output_rescaled = false;
 	if (verbose) cd->verbose = true;
 
@@ -120,6 +120,8 @@ l1l2inv (simeq *eq, char *path_fn, char *info_fn)
 	if (!cdescent_do_pathwise_optimization (cd)) fprintf (stderr, "not converged.\n");
 	fprintf (stderr, "total num of iter = %d\n", cd->total_iter);
 	if (cd->use_intercept) fprintf (stderr, "intercept = %.4e\n", cd->b0);
+	if (verbose && !xj_pool_mmap) fprintf (stderr, "columns of X: %ld %s, %ld served from pool\n",
+		provider_num_reads (lreg->prov), (eq->k) ? "calculated" : "read from files", provider_num_hits (lreg->prov));
 
 	cdescent_free (cd);
 	linregmodel_free (lreg);
@@ -16,8 +16,18 @@
 #include "defaults.h"
 
 extern bool stretch_grid_at_edge;
+extern MMRealXmatFormat	xfile_format;
+extern int				xfile_tile_mb;
+extern int				xfile_rowblock;
+extern bool				xfile_on_the_fly;
 
 bool	create_xmat = true;
+// memory budget of the pool of column buffers of X in MB
+int		xj_pool_mb = 256;
+// map xmat files into memory instead of reading them
+bool	xj_pool_mmap = false;
+// num of columns of X read ahead in background
+int		xj_read_ahead = 0;
 bool	penalty_for_actual_magnetization = false;
 
 void
@@ -53,7 +63,30 @@ usage (char *toolname)
 	fprintf (stderr, "       -p (use parallel CDA: default is not use)\n");
 	fprintf (stderr, "       -c (use stochastic CDA: default is not use)\n");
 	fprintf (stderr, "       -v (verbose mode)\n");
-	fprintf (stderr, "       -x (use already exists xmat files, default=false)\n");
+	fprintf (stderr, "       -x (use already exists xmat file %s if it was created\n", XMATFILE_NAME);
+	fprintf (stderr, "           with the same settings and is not corrupted,\n");
+	fprintf (stderr, "           otherwise it is created again, default=false)\n");
+	fprintf (stderr, "       -F [format of columns of X stored in xmat file:\n");
+	fprintf (stderr, "           0=float64, 1=float32, 2=int16 scaled for each column,\n");
+	fprintf (stderr, "           default is 0. With -x, the format of existing file is used]\n");
+	fprintf (stderr, "       -T [size in MB of a tile of columns of X, which is\n");
+	fprintf (stderr, "           the unit of writing and checksum of xmat file.\n");
+	fprintf (stderr, "           With -B, size of a row block of a tile, default=4]\n");
+	fprintf (stderr, "       -B [num of rows of a row block: rows of X are divided into\n");
+	fprintf (stderr, "           row blocks in xmat file, so that a tile is read by\n");
+	fprintf (stderr, "           its row blocks, and block CDA over the tiles is used,\n");
+	fprintf (stderr, "           -c is ignored. default is not divided.\n");
+	fprintf (stderr, "           With -x, the row blocks of existing file are used]\n");
+	fprintf (stderr, "       -M [memory budget in MB to keep columns of X\n");
+	fprintf (stderr, "           read from xmat file resident, default=256]\n");
+	fprintf (stderr, "       -X (map xmat file into memory by mmap instead of\n");
+	fprintf (stderr, "           reading it, -M is ignored: default is not use)\n");
+	fprintf (stderr, "       -K (calculate columns of X by the kernel function when\n");
+	fprintf (stderr, "           they are used instead of storing them in xmat file,\n");
+	fprintf (stderr, "           they are kept resident within -M. -x, -F, -T, -B\n");
+	fprintf (stderr, "           and -X are ignored: default is not use)\n");
+	fprintf (stderr, "       -R [K: read ahead K columns of X in background\n");
+	fprintf (stderr, "           in cyclic CDA: default is not use]\n");
 	fprintf (stderr, "       -h (show this message)\n\n");
 
 	fprintf (stderr, "       -r [regression type: 0=L1,1=L1L2,2=L1TSV,3=L1L2TSV\n");
@@ -75,7 +108,7 @@ read_input_params (int argc, char **argv)
 	char	c;
 
 	stretch_grid_at_edge = true;
-	while ((c = getopt (argc, argv, ":r:d:a:w:t:m:n:s:b:g:kpcouxvh")) != EOF) {
+	while ((c = getopt (argc, argv, ":r:d:a:w:t:m:n:s:b:g:M:R:F:T:B:kpcouxXKvh")) != EOF) {
 		switch (c) {
 
 			case 'r':
@@ -173,6 +206,46 @@ read_input_params (int argc, char **argv)
 				create_xmat = false;
 				break;
 
+			case 'F':
+				xfile_format = (MMRealXmatFormat) atoi (optarg);
+				if (xfile_format < MM_REAL_XMAT_FLOAT64 || MM_REAL_XMAT_INT16 < xfile_format) {
+					fprintf (stderr, "ERROR: format of xmat files must be 0, 1, or 2\n");
+					return false;
+				}
+				break;
+
+			case 'T':
+				xfile_tile_mb = atoi (optarg);
+				if (xfile_tile_mb <= 0) {
+					fprintf (stderr, "ERROR: size of tile must be > 0\n");
+					return false;
+				}
+				break;
+
+			case 'B':
+				xfile_rowblock = atoi (optarg);
+				if (xfile_rowblock <= 0) {
+					fprintf (stderr, "ERROR: num of rows of a row block must be > 0\n");
+					return false;
+				}
+				break;
+
+			case 'M':
+				xj_pool_mb = atoi (optarg);
+				break;
+
+			case 'X':
+				xj_pool_mmap = true;
+				break;
+
+			case 'K':
+				xfile_on_the_fly = true;
+				break;
+
+			case 'R':
+				xj_read_ahead = atoi (optarg);
+				break;
+
 			case 'v':
 				verbose = true;
 				break;
@@ -204,10 +277,10 @@ read_input_params (int argc, char **argv)
 }
 
 static void
-weight_d (mm_real *d, double *xtx)
+weight_d (penalty *d, double *xtx)
 {
 	int		j;
-	for (j = 0; j < d->n; j++) mm_real_xj_scale (d, j, 1. / sqrt (xtx[j]));
+	for (j = 0; j < d->n; j++) penalty_scale_column (d, j, 1. / sqrt (xtx[j]));
 	return;
 }
 
@@ -220,21 +293,23 @@ run (void)
 	if ((eq = read_input (type, ifn, tfn, weight, create_xmat)) == NULL) return false;
 	if (verbose) fprintf (stderr, "done\n");
 
-	if (penalty_for_actual_magnetization) {
-		double	*xtx;
-		int		n = eq->d->n;
-		FILE	*fp = fopen ("xtx.vec", "rb");
-		if (!fp) {
-			fprintf (stderr, "ERROR: cannot open file xtx.vec.\nprogram abort!\n");
-			exit (1);
-		} else {
-			int	ret;
-			xtx = (double *) malloc (n * sizeof (double));
-			ret = fread (xtx, sizeof (double), n, fp);
-			fclose (fp);
-		}
+	if (penalty_for_actual_magnetization && eq->k) {
+		double	*xtx = kernel_xtx (eq->k);
 		weight_d (eq->d, xtx);
 		free (xtx);
+	} else if (penalty_for_actual_magnetization) {
+		mm_real_xmatfile_header	*h = NULL;
+		FILE	*fp = fopen (XMATFILE_NAME, "rb");
+		if (fp) {
+			h = mm_real_xmatfile_header_read (fp);
+			fclose (fp);
+		}
+		if (!h) {
+			fprintf (stderr, "ERROR: cannot read file %s.\nprogram abort!\n", XMATFILE_NAME);
+			exit (1);
+		}
+		weight_d (eq->d, h->xtx);
+		mm_real_xmatfile_header_free (h);
 	}
 
 	l1l2inv (eq, NULL, NULL);
@@ -1,5 +1,6 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <unistd.h>
 #include <math.h>
 #include <float.h>
 
@@ -7,15 +8,20 @@
 #include "cdescent.h"
 
 #include "simeq_xmat.h"
-#include "smooth.h"
 #include "extern_consts.h"
 
+extern MMRealXmatFormat	xfile_format;
+extern int				xfile_tile_mb;
+extern int				xfile_rowblock;
+extern bool				xfile_on_the_fly;
+
 simeq *
 simeq_new (void)
 {
 	simeq	*eq = (simeq *) malloc (sizeof (simeq));
 	eq->y = NULL;
 	eq->d = NULL;
+	eq->k = NULL;
 	return eq;
 }
 
@@ -24,7 +30,8 @@ simeq_free (simeq *eq)
 {
 	if (eq) {
 		if (eq->y) mm_real_free (eq->y);
-		if (eq->d) mm_real_free (eq->d);
+		if (eq->d) penalty_free (eq->d);
+		if (eq->k) kernel_free (eq->k);
 	}
 	return;
 }
@@ -39,92 +46,392 @@ create_observation (const data_array *array)
 	return y;
 }
 
-static void
-create_kernel_matrix_xmatfile (const double exf_inc, const double exf_dec,
+/* create new kernel, which keeps the observation points and the grid cells,
+ * so that array and gsrc can be freed */
+kernel *
+kernel_new (const double exf_inc, const double exf_dec,
 	const double mag_inc, const double mag_dec,
 	const data_array *array, const grid *gsrc, const mgcal_func *func)
 {
-	int			i, l;
-	int			m = array->n;
-	int			n = gsrc->n;
-	int			nnz = m * n;
+	int			i, j;
+	kernel		*k = (kernel *) malloc (sizeof (kernel));
+	vector3d	*pos = vector3d_new (0., 0., 0.);
+	vector3d	*dim = vector3d_new (0., 0., 0.);
 
-	int			num_xfiles = ngrd[2];
-	int			xfile_len = ngrd[0] * ngrd[1];
+	k->m = array->n;
+	k->n = gsrc->n;
+	k->obs = (double *) malloc (3 * k->m * sizeof (double));
+	k->cell = (double *) malloc (6 * k->n * sizeof (double));
+	if (!k->obs || !k->cell) {
+		fprintf (stderr, "ERROR: cannot allocate memory.\nprogram abort!\n");
+		exit (1);
+	}
+	for (i = 0; i < k->m; i++) {
+		k->obs[3 * i] = array->x[i];
+		k->obs[3 * i + 1] = array->y[i];
+		k->obs[3 * i + 2] = array->z[i];
+	}
+	for (j = 0; j < k->n; j++) {
+		double	*c = k->cell + 6 * j;
+		grid_get_nth (gsrc, j, pos, dim);
+		c[0] = pos->x;
+		c[1] = pos->y;
+		c[2] = pos->z;
+		c[3] = dim->x;
+		c[4] = dim->y;
+		c[5] = dim->z;
+	}
+	vector3d_free (pos);
+	vector3d_free (dim);
 
-	vector3d	*exf;
-	vector3d	*mag;
+	k->exf = vector3d_new_with_geodesic_poler (1., exf_inc, exf_dec);
+	k->mag = vector3d_new_with_geodesic_poler (1., mag_inc, mag_dec);
+	k->function = func->function;
+	k->parameter = func->parameter;
+	return k;
+}
 
-	mm_real		*w = mm_real_new (MM_REAL_DENSE, MM_REAL_GENERAL, n, 1, n);
-	mm_real		*s = mm_real_new (MM_REAL_DENSE, MM_REAL_GENERAL, n, 1, n);
+void
+kernel_free (kernel *k)
+{
+	if (k) {
+		if (k->obs) free (k->obs);
+		if (k->cell) free (k->cell);
+		if (k->exf) vector3d_free (k->exf);
+		if (k->mag) vector3d_free (k->mag);
+		free (k);
+	}
+	return;
+}
 
-	bool		nextfile;
-	FILE		*fp = NULL;
+/* calculate the rows i0, ..., i0 + mb - 1 of j-th column of X into xb (size mb).
+ * This is called concurrently by the threads, so the source is created for each call */
+static void
+kernel_rows (const kernel *k, const int j, const int i0, const int mb, double *xb)
+{
+	int			i;
+	double		*c = k->cell + 6 * j;
+	vector3d	*obs = vector3d_new (0., 0., 0.);
+	source		*src = source_new (0., 0.);
 
-	exf = vector3d_new_with_geodesic_poler (1., exf_inc, exf_dec);
-	mag = vector3d_new_with_geodesic_poler (1., mag_inc, mag_dec);
+	src->exf = vector3d_copy (k->exf);
+	source_append_item (src);
+	src->begin->pos = vector3d_new (c[0], c[1], c[2]);
+	src->begin->dim = vector3d_new (c[3], c[4], c[5]);
+	src->begin->mgz = vector3d_copy (k->mag);
 
-#pragma omp parallel for private (i)
-	for (l = 0; l < num_xfiles; l++) {
-		int		k;
-		char	fn[80];
-		FILE	*fp_xmat;
+	for (i = 0; i < mb; i++) {
+		const double	*o = k->obs + 3 * ((size_t) i0 + i);
+		vector3d_set (obs, o[0], o[1], o[2]);
+		xb[i] = k->function (obs, src, k->parameter);
+	}
+	vector3d_free (obs);
+	source_free (src);
+	return;
+}
 
-		mm_real	*xj = mm_real_new (MM_REAL_DENSE, MM_REAL_GENERAL, m, 1, m);
+/* calculate j-th column of X into xj (size m), where data is the kernel.
+ * This is the provider_column_func of the column provider */
+void
+kernel_column (const int j, double *xj, void *data)
+{
+	kernel	*k = (kernel *) data;
+	kernel_rows (k, j, 0, k->m, xj);
+	return;
+}
 
-		vector3d	*obs = vector3d_new (0., 0., 0.);
-		source		*src = source_new (0., 0.);
-		src->exf = vector3d_copy (exf);
-		source_append_item (src);
-		src->begin->pos = vector3d_new (0., 0., 0.);
-		src->begin->dim = vector3d_new (0., 0., 0.);
-		src->begin->mgz = vector3d_copy (mag);
+/* return X(:,j)' * X(:,j) of the columns of X calculated by the kernel: size n */
+double *
+kernel_xtx (const kernel *k)
+{
+	int		j;
+	double	*xtx = (double *) malloc (k->n * sizeof (double));
 
-		sprintf (fn, "x%03d.mat", l);
-		fp_xmat = fopen (fn, "wab");
-		if (!fp_xmat) {
-			fprintf (stderr, "ERROR: cannot open file %s.\nprogram abort!\n", fn);
+#pragma omp parallel
+	{
+		mm_real	*xj = mm_real_new (MM_REAL_DENSE, MM_REAL_GENERAL, k->m, 1, k->m);
+#pragma omp for schedule(dynamic, 1)
+		for (j = 0; j < k->n; j++) {
+			kernel_column (j, xj->data, (void *) k);
+			xtx[j] = mm_real_xj_ssq (xj, 0);
+		}
+		mm_real_free (xj);
+	}
+	return xtx;
+}
+
+/* fingerprint of the settings which X is calculated from:
+ * the directions of the external field and the magnetization, the scale factor,
+ * the observation points and the grid cells of the sources */
+static uint64_t
+xmatfile_fingerprint (const double exf_inc, const double exf_dec,
+	const double mag_inc, const double mag_dec,
+	const data_array *array, const grid *gsrc)
+{
+	int			j;
+	int			m = array->n;
+	double		v[5];
+	uint64_t	hash = MM_REAL_XMATFILE_HASH_INIT;
+	vector3d	*pos = vector3d_new (0., 0., 0.);
+	vector3d	*dim = vector3d_new (0., 0., 0.);
+
+	v[0] = exf_inc;
+	v[1] = exf_dec;
+	v[2] = mag_inc;
+	v[3] = mag_dec;
+	v[4] = mgcal_get_scale_factor ();
+	hash = mm_real_xmatfile_hash (v, sizeof (v), hash);
+
+	hash = mm_real_xmatfile_hash (array->x, m * sizeof (double), hash);
+	hash = mm_real_xmatfile_hash (array->y, m * sizeof (double), hash);
+	hash = mm_real_xmatfile_hash (array->z, m * sizeof (double), hash);
+
+	for (j = 0; j < gsrc->n; j++) {
+		double	c[6];
+		grid_get_nth (gsrc, j, pos, dim);
+		c[0] = pos->x;
+		c[1] = pos->y;
+		c[2] = pos->z;
+		c[3] = dim->x;
+		c[4] = dim->y;
+		c[5] = dim->z;
+		hash = mm_real_xmatfile_hash (c, sizeof (c), hash);
+	}
+	vector3d_free (pos);
+	vector3d_free (dim);
+
+	return hash;
+}
+
+/* whether the existing container XMATFILE_NAME holds X of size m x n
+ * calculated from the settings of fingerprint, and its tiles are not corrupted */
+static bool
+xmatfile_is_reusable (const int m, const int n, const uint64_t fingerprint)
+{
+	bool					reusable = false;
+	mm_real_xmatfile_header	*h;
+	FILE					*fp = fopen (XMATFILE_NAME, "rb");
+
+	if (!fp) {
+		fprintf (stderr, "WARNING: %s is not found.\n", XMATFILE_NAME);
+		return false;
+	}
+	if ((h = mm_real_xmatfile_header_read (fp)) == NULL)
+		fprintf (stderr, "WARNING: %s is not a valid xmat file.\n", XMATFILE_NAME);
+	else if (h->m != m || h->n != n)
+		fprintf (stderr, "WARNING: size of X in %s is [%d, %d], but [%d, %d] is required.\n", XMATFILE_NAME, h->m, h->n, m, n);
+	else if (h->fingerprint != fingerprint)
+		fprintf (stderr, "WARNING: %s was created with other settings.\n", XMATFILE_NAME);
+	else if (!mm_real_xmatfile_verify (fp, h))
+		fprintf (stderr, "WARNING: checksum of %s does not match.\n", XMATFILE_NAME);
+	else reusable = true;
+
+	if (h) mm_real_xmatfile_header_free (h);
+	fclose (fp);
+	return reusable;
+}
+
+/* write buf of len bytes at offset of file fd */
+static void
+xmatfile_pwrite (const int fd, const char *buf, const size_t len, const off_t offset)
+{
+	size_t	done = 0;
+	while (done < len) {
+		ssize_t	ret = pwrite (fd, buf + done, len - done, offset + (off_t) done);
+		if (ret <= 0) {
+			fprintf (stderr, "ERROR: failed to write file %s.\nprogram abort!\n", XMATFILE_NAME);
 			exit (1);
 		}
-		for (k = 0; k < xfile_len; k++) {
-			int		j = k + l * xfile_len;
-			grid_get_nth (gsrc, j, src->begin->pos, src->begin->dim);
-			for (i = 0; i < m; i++) {
-				vector3d_set (obs, array->x[i], array->y[i], array->z[i]);
-				xj->data[i] = func->function (obs, src, func->parameter);
+		done += (size_t) ret;
+	}
+	return;
+}
+
+/* allocate the buffer of len bytes aligned to MM_REAL_XMATFILE_ALIGN */
+static char *
+xmatfile_buffer_new (size_t len)
+{
+	void	*p;
+	len = ((len + MM_REAL_XMATFILE_ALIGN - 1) / MM_REAL_XMATFILE_ALIGN) * MM_REAL_XMATFILE_ALIGN;
+	if (posix_memalign (&p, MM_REAL_XMATFILE_ALIGN, len) != 0) {
+		fprintf (stderr, "ERROR: cannot allocate memory.\nprogram abort!\n");
+		exit (1);
+	}
+	return (char *) p;
+}
+
+/* calculate the normalized columns of X and store them in the tiles of h of file fd,
+ * where the rows of X are not divided.
+ * The columns are distributed to the threads one by one, so that all threads work
+ * even if X has only a few tiles. Each tile is encoded into its own aligned buffer,
+ * and the thread which completes the last column of the tile calculates its checksum
+ * and writes it at once by pwrite at the position of the tile.
+ * Since the columns are handed out in order, only the tiles being calculated
+ * (at most the num of threads + 1) hold their buffers */
+static void
+xmatfile_write_tiles (const kernel *k, mm_real_xmatfile_header *h, const int fd)
+{
+	int			j;
+	int			*remain;
+	char		**buf;
+
+	// num of columns of each tile not calculated yet, and buffer of each tile
+	remain = (int *) malloc (h->ntiles * sizeof (int));
+	buf = (char **) malloc (h->ntiles * sizeof (char *));
+	if (!remain || !buf) {
+		fprintf (stderr, "ERROR: cannot allocate memory.\nprogram abort!\n");
+		exit (1);
+	}
+	for (j = 0; j < h->ntiles; j++) {
+		remain[j] = mm_real_xmatfile_tile_ncols (h, j);
+		buf[j] = NULL;
+	}
+
+#pragma omp parallel
+	{
+		mm_real	*xj = mm_real_new (MM_REAL_DENSE, MM_REAL_GENERAL, h->m, 1, h->m);
+
+#pragma omp for schedule(dynamic, 1)
+		for (j = 0; j < h->n; j++) {
+			int		t = j / h->tile;
+			int		left;
+			char	*tbuf;
+
+			// buffer of the tile is allocated by the first thread which reaches it
+#pragma omp critical (xmatfile_tile)
+			{
+				if (buf[t] == NULL) buf[t] = xmatfile_buffer_new ((size_t) mm_real_xmatfile_tile_ncols (h, t) * h->reclen);
+				tbuf = buf[t];
 			}
-			s->data[j] = mm_real_xj_sum (xj, 0);
-			w->data[j] = mm_real_xj_ssq (xj, 0);
+
+			kernel_column (j, xj->data, (void *) k);
+			h->sx[j] = mm_real_xj_sum (xj, 0);
+			h->xtx[j] = mm_real_xj_ssq (xj, 0);
 			// normalize
-			mm_real_xj_scale (xj, 0, 1. / sqrt (w->data[j]));
-			fwrite (xj->data, sizeof (double), m, fp_xmat);
+			mm_real_xj_scale (xj, 0, 1. / sqrt (h->xtx[j]));
+			mm_real_xmatfile_encode (h->format, h->m, xj->data, tbuf + mm_real_xmatfile_record_offset (h, j, 0));
+
+#pragma omp critical (xmatfile_tile)
+			left = --remain[t];
+
+			// the tile is completed by this thread
+			if (left == 0) {
+				size_t	len = (size_t) mm_real_xmatfile_tile_ncols (h, t) * h->reclen;
+				h->checksum[t] = mm_real_xmatfile_hash (tbuf, len, MM_REAL_XMATFILE_HASH_INIT);
+				xmatfile_pwrite (fd, tbuf, len, (off_t) mm_real_xmatfile_tile_offset (h, t));
+				free (tbuf);
+			}
 		}
-		fclose (fp_xmat);
+
 		mm_real_free (xj);
-		vector3d_free (obs);
-		source_free (src);
 	}
+	free (remain);
+	free (buf);
 
-	fp = fopen("xs.vec", "wb");
-	if (!fp) {
-		fprintf (stderr, "ERROR: cannot open file xs.vec.\nprogram abort!\n");
-		exit (1);
+	return;
+}
+
+/* calculate the normalized columns of X and store them in the tiles of h of file fd,
+ * where the rows of X are divided into the row blocks.
+ * m is large in this case, so neither a whole column nor a whole tile is held:
+ * sum and squared norm of the columns are calculated by their row blocks at first,
+ * then each row block of a tile is calculated by the threads over its columns,
+ * normalized, encoded into the buffer, hashed into the checksum of the tile
+ * and written by pwrite in order. So only a row block of a tile (about -T MB)
+ * and a row block of a column of each thread are held,
+ * at the cost of calculating X twice */
+static void
+xmatfile_write_rowblocks (const kernel *k, mm_real_xmatfile_header *h, const int fd)
+{
+	int			j;
+	char		*buf = xmatfile_buffer_new ((size_t) h->tile * mm_real_xmatfile_record_size (h->format, h->rowblock));
+
+#pragma omp parallel
+	{
+		int		t;
+		double	*xb = (double *) malloc (h->rowblock * sizeof (double));
+		if (!xb) {
+			fprintf (stderr, "ERROR: cannot allocate memory.\nprogram abort!\n");
+			exit (1);
+		}
+
+#pragma omp for schedule(dynamic, 1)
+		for (j = 0; j < h->n; j++) {
+			int		i, b;
+			double	sx = 0.;
+			double	xtx = 0.;
+			for (b = 0; b < h->nrowblocks; b++) {
+				int		mb = mm_real_xmatfile_block_nrows (h, b);
+				kernel_rows (k, j, b * h->rowblock, mb, xb);
+				for (i = 0; i < mb; i++) {
+					sx += xb[i];
+					xtx += xb[i] * xb[i];
+				}
+			}
+			h->sx[j] = sx;
+			h->xtx[j] = xtx;
+		}
+
+		for (t = 0; t < h->ntiles; t++) {
+			int		j0 = t * h->tile;
+			int		nc = mm_real_xmatfile_tile_ncols (h, t);
+			int		b;
+#pragma omp single
+			h->checksum[t] = MM_REAL_XMATFILE_HASH_INIT;
+			for (b = 0; b < h->nrowblocks; b++) {
+				int		i;
+				int		mb = mm_real_xmatfile_block_nrows (h, b);
+				size_t	start = mm_real_xmatfile_record_offset (h, j0, b);
+
+#pragma omp for schedule(dynamic, 1)
+				for (j = j0; j < j0 + nc; j++) {
+					double	s = 1. / sqrt (h->xtx[j]);
+					kernel_rows (k, j, b * h->rowblock, mb, xb);
+					// normalize
+					for (i = 0; i < mb; i++) xb[i] *= s;
+					mm_real_xmatfile_encode (h->format, mb, xb, buf + mm_real_xmatfile_record_offset (h, j, b) - start);
+				}
+				// implicit barrier of omp for: the row block is completed
+#pragma omp single
+				{
+					size_t	len = mm_real_xmatfile_block_size (h, t, b);
+					h->checksum[t] = mm_real_xmatfile_hash (buf, len, h->checksum[t]);
+					xmatfile_pwrite (fd, buf, len, (off_t) (mm_real_xmatfile_tile_offset (h, t) + start));
+				}
+			}
+		}
+
+		free (xb);
 	}
-	fwrite (s->data, sizeof (double), n, fp);
-	fclose (fp);
-	mm_real_free (s);
+	free (buf);
+
+	return;
+}
+
+/* calculate the normalized columns of X and store them in the container XMATFILE_NAME.
+ * A tile is -T MB, or a row block of a tile is -T MB if the rows are divided by -B,
+ * so that the row blocks which are read at once are large even if a column exceeds -T MB */
+static void
+create_kernel_matrix_xmatfile (const kernel *k, const uint64_t fingerprint)
+{
+	int			tile = mm_real_xmatfile_tile_width (xfile_format, k->m, xfile_rowblock, (size_t) xfile_tile_mb << 20);
+	FILE		*fp;
+
+	mm_real_xmatfile_header	*h = mm_real_xmatfile_header_new (xfile_format, k->m, k->n, tile, xfile_rowblock, fingerprint);
 
-	fp = fopen("xtx.vec", "wb");
+	fp = fopen (XMATFILE_NAME, "wb");
 	if (!fp) {
-		fprintf (stderr, "ERROR: cannot open file xtx.vec\nprogram abort!\n");
+		fprintf (stderr, "ERROR: cannot open file %s.\nprogram abort!\n", XMATFILE_NAME);
 		exit (1);
 	}
-	fwrite (w->data, sizeof (double), n, fp);
+	if (h->rowblock < h->m) xmatfile_write_rowblocks (k, h, fileno (fp));
+	else xmatfile_write_tiles (k, h, fileno (fp));
+
+	// header is written at last, so that the interrupted container is not reused
+	mm_real_xmatfile_header_write (fp, h);
 	fclose (fp);
-	mm_real_free (w);
 
-	vector3d_free (exf);
-	vector3d_free (mag);
+	mm_real_xmatfile_header_free (h);
 
 	return;
 }
@@ -140,17 +447,30 @@ create_simeq (const int type, const double exf_inc, const double exf_dec,
 
 	eq = simeq_new ();
 	if (array) eq->y = create_observation (array);
-	if (create_xmat) create_kernel_matrix_xmatfile (exf_inc, exf_dec, mag_inc, mag_dec, array, gsrc, func);
+	if (array) {
+		kernel	*k = kernel_new (exf_inc, exf_dec, mag_inc, mag_dec, array, gsrc, func);
+		if (xfile_on_the_fly) eq->k = k;
+		else {
+			uint64_t	fingerprint = xmatfile_fingerprint (exf_inc, exf_dec, mag_inc, mag_dec, array, gsrc);
+			// existing container is reused only if it is verified, otherwise it is created again
+			if (create_xmat || !xmatfile_is_reusable (array->n, gsrc->n, fingerprint))
+				create_kernel_matrix_xmatfile (k, fingerprint);
+			kernel_free (k);
+		}
+	}
 
+	/* D is not stored, see mm_real_smooth_1 and mm_real_smooth_l01_1 of smooth.c for its structure */
 	switch (type) {
 		case TYPE_L1L2:
-			eq->d = mm_real_eye (MM_REAL_SPARSE, gsrc->n);
+			eq->d = penalty_new_identity (gsrc->n, 1.);
 			break;
 		case TYPE_L1TSV:
-			eq->d = mm_real_smooth_1 (MM_REAL_SPARSE, gsrc->nx, gsrc->ny, gsrc->nz, w);
+			if (w) eq->d = penalty_new_stencil (gsrc->nx, gsrc->ny, gsrc->nz, 0., w[0], w[1], w[2]);
+			else eq->d = penalty_new_stencil (gsrc->nx, gsrc->ny, gsrc->nz, 0., 1., 1., 1.);
 			break;
 		case TYPE_L1L2TSV:
-			eq->d = mm_real_smooth_l01_1 (MM_REAL_SPARSE, gsrc->nx, gsrc->ny, gsrc->nz, w);
+			if (w) eq->d = penalty_new_stencil (gsrc->nx, gsrc->ny, gsrc->nz, w[0], w[1], w[2], w[3]);
+			else eq->d = penalty_new_stencil (gsrc->nx, gsrc->ny, gsrc->nz, 1., 1., 1., 1.);
 			break;
 		default:
 			break;
@@ -225,11 +225,11 @@ printf_estimated (const cdescent *cd, const mm_dense *beta)
 	mm_dense	*c;
 	FILE		*fp;
 
-	m = cd->lreg->m;
+	m = *cd->m;
 	c = mm_real_new (MM_REAL_DENSE, MM_REAL_GENERAL, m, 1, m);
 	mm_real_set_all (c, 0.);
 	if ((fp = fopen ("estimated.data", "w")) == NULL) return;
-	mm_real_x_dot_yk_xmatfile (cd->lreg->fp_xmat, cd->lreg->m, cd->lreg->n, false, 1., beta, 0, 0., c);
+	provider_dot_y (false, 1., cd->lreg->prov, beta, 0., c);
 	mm_real_fwrite (fp, c, NULL);
 	fclose (fp);
 	mm_real_free (c);
@@ -18,9 +18,13 @@ static bool	beta_file_specified = false;
 static char	fn[80];
 static bool	input_file_specified = false;
 
+extern bool	stretch_grid_at_edge;
+
 bool		create_xmat = true;
-int			num_xfiles;
-int			xfile_len;
+MMRealXmatFormat	xfile_format = MM_REAL_XMAT_FLOAT64;
+int			xfile_tile_mb = 4;
+int			xfile_rowblock = 0;
+bool		xfile_on_the_fly = false;
 
 
 void
@@ -72,6 +76,8 @@ read_input_params (int argc, char **argv)
 {
 	char	c;
 
+	// grid is same as l1l2inv_xmat, so that xmat file of the inversion is reused
+	stretch_grid_at_edge = true;
 	while ((c = getopt (argc, argv, "f:i:d:s:xh")) != EOF) {
 		switch (c) {
 			case 'f':
@@ -105,16 +111,13 @@ int
 main (int argc, char **argv)
 {
 	int			i;
-	int			m, n, ret;
-
-	double		*xtx;
+	int			m, n;
 
 	simeq		*eq;
 	mm_dense	*beta;
 	mm_dense	*f;
 
-	FILE		**fp_xmat;
-	FILE		*fp_xtx;
+	provider	*prov;
 
 	if (!read_input_params (argc, argv)) {
 		usage (argv[0]);
@@ -128,28 +131,12 @@ main (int argc, char **argv)
 
 	m = eq->y->m;
 	n = ngrd[0] * ngrd[1] * ngrd[2];
-	num_xfiles = ngrd[2];
-	xfile_len = ngrd[0] * ngrd[1];
-
-	fp_xmat = (FILE **) malloc (num_xfiles * sizeof (FILE *));
-	for (i = 0; i < num_xfiles; i++) {
-		char	fn[80];
-		sprintf (fn, "x%03d.mat", i);
-		fp_xmat[i] = fopen (fn, "rb");
-		if (!fp_xmat[i]) {
-			fprintf (stderr, "ERROR: cannot open file %s.program abort!\n", fn);
-			exit (1);
-		}
-	}
-
-	fp_xtx = fopen ("xtx.vec", "rb");
-	if (!fp_xtx) {
-		fprintf (stderr, "ERROR: cannot open file xtx.vec.\nprogram abort!\n");
-		exit (1);
+	// columns are read once, no column is kept resident
+	prov = provider_new_xmatfile (XMATFILE_NAME, 0);
+	if (prov->m != m || prov->n != n) {
+		fprintf (stderr, "ERROR: size of X in %s does not match.\n", XMATFILE_NAME);
+		exit (EXIT_FAILURE);
 	}
-	xtx = (double *) malloc (n * sizeof (double));
-	ret = fread (xtx, sizeof (double), n, fp_xtx);
-	fclose (fp_xtx);
 
 	// extract beta
 	beta = extract_beta (fn, iter);
@@ -157,16 +144,14 @@ main (int argc, char **argv)
 		fprintf (stderr, "ERROR: failed to read %d-th beta.\n", iter);
 		exit (EXIT_FAILURE);
 	}
-	for (i = 0; i < n; i++) beta->data[i] *= sqrt (xtx[i]);
+	for (i = 0; i < n; i++) beta->data[i] *= sqrt (prov->xtx[i]);
 
 	// calc and output z = X * beta
 	f = mm_real_new (MM_REAL_DENSE, MM_REAL_GENERAL, m, 1, m);
-	mm_real_set_all (f, 0.);
-	mm_real_x_dot_yk_xmatfile (fp_xmat, m, n, false, 1., beta, 0, 0., f);
+	provider_dot_y (false, 1., prov, beta, 0., f);
 	mm_real_free (beta);
 	simeq_free (eq);
-	for (i = 0; i < num_xfiles; i++) fclose (fp_xmat[i]);
-	free (fp_xmat);
+	provider_free (prov);
 
 	if (!input_file_specified) strcpy (ifn, "input.data");
 	fprintf_estimated (stdout, ifn, f->data, NULL);